@@ -0,0 +1,52 @@
+/* Budget.hpp
+ * Limites de temps et de mémoire vérifiées de manière coopérative par les boucles de recherche : à l'épuisement,
+ * une exception remonte la pile d'appels et la réponse devient UNKNOWN. */
+
+#ifndef BUDGET_HPP
+#define BUDGET_HPP
+
+#include <cstdint>  // uint64_t
+#include <cstddef>  // size_t
+#include <stdexcept>  // std::runtime_error
+#include <string>  // std::string
+
+
+// Exception levée quand la limite de temps ou de mémoire est atteinte
+class BudgetEpuise : public std::runtime_error {
+public:
+    explicit BudgetEpuise(const std::string& message)
+        : std::runtime_error(message) {}
+};
+
+// Budget du thread courant : chaque thread (requête) a ses propres limites et compteurs
+namespace Budget {
+    // Bilan partiel de la recherche
+    struct Statistiques {
+        uint64_t noeuds = 0;  // Appels de verifier() depuis configurer()
+        double secondes = 0.0;  // Temps écoulé depuis configurer()
+        size_t memoireMo = 0;  // Pic de mémoire résidente du processus
+    };
+
+    // Fixe les limites (0 = pas de limite), démarre le chronomètre et relève la mémoire résidente de départ :
+    // la limite de mémoire porte sur la croissance depuis cet appel de la mémoire résidente du processus entier
+    // (les allocations des autres threads pendant la requête comptent aussi)
+    void configurer(double secondesMax, size_t memoireMaxMo);
+    // Retourne le bilan courant
+    Statistiques statistiques();
+    // Contrôle effectif des limites, lance BudgetEpuise si l'une est dépassée
+    void verifierLimites();
+
+    namespace detail {
+        inline thread_local uint64_t compteurNoeuds = 0;
+        inline thread_local bool actif = false;  // Vrai si au moins une limite est fixée
+    }
+
+    // Point de contrôle appelé à chaque nœud de recherche : l'horloge et la mémoire ne sont lues
+    // que tous les 1024 nœuds pour garder un coût négligeable
+    inline void verifier() {
+        ++detail::compteurNoeuds;
+        if (detail::actif && (detail::compteurNoeuds & 1023) == 0) verifierLimites();
+    }
+}
+
+#endif // BUDGET_HPP
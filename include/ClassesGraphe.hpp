@@ -0,0 +1,50 @@
+/* ClassesGraphe.hpp
+ * Classification structurelle d'un système d'argumentation (acyclique, symétrique, biparti, sans cycle impair) et
+ * procédures polynomiales propres à ces classes, où les sémantiques préférée et stable coïncident. */
+
+#ifndef CLASSES_GRAPHE_HPP
+#define CLASSES_GRAPHE_HPP
+
+#include <vector>  // std::vector
+#include <string>  // std::string
+#include "SystemeArgumentation.hpp"
+#include "Utilitaires.hpp"
+
+
+// Propriétés du graphe des attaques, calculées une seule fois en O(n + m log m)
+struct ClassificationGraphe {
+    bool acyclique = false;  // Aucun cycle (auto-attaque comprise) : fondée = stable = préférée
+    bool symetrique = false;  // Attaques symétriques et aucune auto-attaque : stable = préférée = naïve
+    bool biparti = false;  // Graphe non orienté sous-jacent biparti : acceptation polynomiale (Dunne)
+    bool sansCycleImpair = false;  // Aucun cycle orienté de longueur impaire : système cohérent (préférée = stable)
+    std::vector<int> cote;  // Si biparti : côté (0 ou 1) de chaque argument dans la bipartition
+
+    // Vrai si les extensions préférées et stables coïncident (et qu'il existe donc au moins une extension stable)
+    bool estCoherent() const { return acyclique || symetrique || sansCycleImpair; }
+    // Nom de la classe la plus précise, pour l'affichage
+    std::string nom() const;
+};
+
+namespace ClassesGraphe {
+    // Composantes fortement connexes (Tarjan), numérotées dans l'ordre topologique inverse : une composante ne
+    // reçoit son numéro qu'après toutes celles qu'elle attaque. Retourne le numéro de composante de chaque argument
+    std::vector<int> composantesFortes(const std::vector<std::vector<int>>& adjacence, int& nbComposantes);
+
+    // Détecte les cycles (composantes fortement connexes), la symétrie, la bipartition et les cycles impairs
+    ClassificationGraphe classifier(const SystemeArgumentation& sa);
+
+    // Système symétrique sans auto-attaque : extension stable (ensemble sans conflit maximal) contenant depart,
+    // construite gloutonnement dans l'ordre des identifiants
+    Utilitaires::EnsembleIds extensionNaive(const SystemeArgumentation& sa, int depart);
+
+    // Système biparti : acceptables[i] est vrai si l'argument i appartient à une extension préférée
+    // Pour chaque côté, on retire jusqu'au point fixe les arguments dont un attaquant n'est pas contré,
+    // ce qui laisse le plus grand ensemble admissible inclus dans ce côté
+    std::vector<bool> argumentsAcceptablesBiparti(const SystemeArgumentation& sa, const std::vector<int>& cote);
+    // Système biparti : extension préférée (donc stable) contenant depart, qui doit être acceptable, ou quelconque si
+    // depart vaut -1. Construite en ajoutant des ensembles admissibles dans des réduits successifs
+    Utilitaires::EnsembleIds extensionBipartie(const SystemeArgumentation& sa, const std::vector<int>& cote,
+                                               int depart);
+}
+
+#endif // CLASSES_GRAPHE_HPP
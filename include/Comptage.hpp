@@ -0,0 +1,24 @@
+/* Comptage.hpp
+ * Comptage des extensions stables et préférées (tâches CE) par décomposition en composantes connexes du graphe
+ * résiduel, les sous-comptes étant mis en cache selon l'état résiduel de chaque composante. */
+
+#ifndef COMPTAGE_HPP
+#define COMPTAGE_HPP
+
+#include "SystemeArgumentation.hpp"
+#include "GrandEntier.hpp"
+
+
+namespace Comptage {
+    // Nombre d'extensions stables, ou de celles qui contiennent argId si argId >= 0
+    // Recherche par labelling (IN ou exclu) avec propagation unitaire : dès que les arguments non décidés forment
+    // plusieurs composantes indépendantes, le compte est le produit des comptes de chacune
+    GrandEntier compterStables(const SystemeArgumentation& sa, int argId = -1);
+
+    // Nombre d'extensions préférées, ou de celles qui contiennent argId si argId >= 0
+    // Le produit porte sur les composantes connexes du système : une composante sans cycle impair est comptée comme
+    // en stable (les deux sémantiques y coïncident), les autres par énumération de leurs extensions complètes maximales
+    GrandEntier compterPreferees(const SystemeArgumentation& sa, int argId = -1);
+}
+
+#endif // COMPTAGE_HPP
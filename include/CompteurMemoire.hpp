@@ -0,0 +1,73 @@
+/* CompteurMemoire.hpp
+ * Comptabilité mémoire par phase (chargement, prétraitement, recherche) : chaque thread déclare sa phase courante et
+ * les allocations du tas lui sont imputées. Le comptage lui-même est fait par les opérateurs new/delete remplacés
+ * dans AllocateurCompteur.cpp, liés au seul exécutable : dans la bibliothèque partagée, les compteurs restent à zéro. */
+
+#ifndef COMPTEUR_MEMOIRE_HPP
+#define COMPTEUR_MEMOIRE_HPP
+
+#include <atomic>  // std::atomic
+#include <cstddef>  // size_t
+#include <cstdint>  // uint64_t, int64_t
+#include <ostream>  // std::ostream
+#include "SystemeArgumentation.hpp"
+
+
+namespace CompteurMemoire {
+    // Phase à laquelle sont imputées les allocations du thread courant
+    enum class Phase { AUTRE, CHARGEMENT, PRETRAITEMENT, RECHERCHE };
+    constexpr size_t NB_PHASES = 4;
+
+    // Bilan d'une phase, depuis l'activation du comptage
+    struct BilanPhase {
+        uint64_t allocations = 0;  // Nombre d'appels à operator new
+        uint64_t octetsAlloues = 0;  // Cumul des blocs alloués (taille réelle du bloc, pas la taille demandée)
+        int64_t picOctets = 0;  // Plus haut niveau du tas vivant observé pendant une allocation de cette phase
+    };
+
+    // Bilan global
+    struct Bilan {
+        bool actif = false;  // Faux si le comptage n'a pas été activé ou si l'allocateur n'est pas lié
+        BilanPhase phases[NB_PHASES];
+        int64_t octetsVivants = 0;  // Tas vivant actuel (les blocs alloués avant l'activation n'y figurent pas)
+        int64_t picOctets = 0;  // Plus haut niveau du tas vivant, toutes phases confondues
+    };
+
+    // Démarre le comptage ; sans effet sur la bibliothèque partagée, où new/delete ne sont pas remplacés
+    void activer();
+    // Instantané des compteurs
+    Bilan bilan();
+    // Nom de la phase dans le rapport JSON
+    const char* nomPhase(Phase phase);
+    // Écrit le rapport JSON : structures des systèmes fournis (original, puis réduit s'il est donné) et compteurs
+    // par phase, relevés par l'appelant avant toute allocation qui ne doit pas y figurer
+    void ecrireRapport(std::ostream& sortie, const Bilan& compteurs, const SystemeArgumentation* original = nullptr,
+                       const SystemeArgumentation* reduit = nullptr);
+
+    namespace detail {
+        inline thread_local Phase phaseCourante = Phase::AUTRE;
+        inline std::atomic<bool> actif{false};
+        // Appelés par les opérateurs remplacés, sans jamais allouer eux-mêmes
+        void enregistrerAllocation(size_t octets);
+        void enregistrerLiberation(size_t octets);
+    }
+
+    // Phase du thread courant, à transmettre aux threads qu'il lance
+    inline Phase phaseCourante() {
+        return detail::phaseCourante;
+    }
+
+    // Impute les allocations du thread courant à une phase jusqu'à la fin de la portée, puis rétablit la précédente
+    class PorteePhase {
+    private:
+        Phase precedente_;
+
+    public:
+        explicit PorteePhase(Phase phase) : precedente_(detail::phaseCourante) { detail::phaseCourante = phase; }
+        ~PorteePhase() { detail::phaseCourante = precedente_; }
+        PorteePhase(const PorteePhase&) = delete;
+        PorteePhase& operator=(const PorteePhase&) = delete;
+    };
+}
+
+#endif // COMPTEUR_MEMOIRE_HPP
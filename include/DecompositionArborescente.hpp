@@ -0,0 +1,60 @@
+/* DecompositionArborescente.hpp
+ * Moteur par programmation dynamique sur une décomposition arborescente du graphe d'attaque non orienté : la
+ * décomposition vient d'un ordre d'élimination de degré minimal et chaque sac résume les extensions partielles de son
+ * sous-arbre. Le temps est linéaire en le nombre d'arguments et exponentiel seulement en la largeur. */
+
+#ifndef DECOMPOSITION_ARBORESCENTE_HPP
+#define DECOMPOSITION_ARBORESCENTE_HPP
+
+#include <vector>  // std::vector
+#include <optional>  // std::optional
+#include "SystemeArgumentation.hpp"
+#include "Utilitaires.hpp"
+
+
+// Décomposition arborescente d'un système et requêtes stables / admissibles par programmation dynamique
+// Le système doit rester en vie (et inchangé) tant que la décomposition est utilisée
+class DecompositionArborescente {
+public:
+    // Largeur au-delà de laquelle on renonce : les tables d'un sac ont jusqu'à 5^(largeur + 1) entrées
+    static constexpr int LARGEUR_MAX = 7;
+
+    // Élimine les arguments par degré minimal ; s'arrête dès que le degré minimal dépasse largeurMax
+    explicit DecompositionArborescente(const SystemeArgumentation& sa, int largeurMax = LARGEUR_MAX);
+
+    // Vrai si la décomposition a été menée à terme avec une largeur au plus largeurMax
+    bool estApplicable() const;
+    // Largeur de la décomposition (taille du plus grand sac moins un), ou la largeur atteinte à l'abandon
+    int getLargeur() const;
+
+    // Les témoins optionnels reçoivent l'ensemble reconstruit depuis les tables : extension trouvée (DC, existence)
+    // ou contre-exemple (DS, absent s'il n'existe aucune extension stable), comme pour NoyauCompact
+
+    // Decision Credulous DC : en préféré, il suffit d'un ensemble admissible contenant l'argument
+    bool credulousStable(int argId, std::optional<Utilitaires::EnsembleIds>* temoin = nullptr) const;
+    bool credulousPreferred(int argId, std::optional<Utilitaires::EnsembleIds>* temoin = nullptr) const;
+
+    // Decision Skeptical DS en stable (le sceptique préféré n'est pas traité ici)
+    bool skepticalStable(int argId, std::optional<Utilitaires::EnsembleIds>* temoin = nullptr) const;
+
+    // Existence d'au moins une extension stable
+    bool existeStable(std::optional<Utilitaires::EnsembleIds>* temoin = nullptr) const;
+
+private:
+    // Ensemble recherché par la programmation dynamique
+    enum class Mode { STABLE, ADMISSIBLE };
+
+    // Cherche un ensemble du mode donné où l'argument argForce (s'il est >= 0) est dedans ou dehors selon dedans
+    bool resoudre(Mode mode, int argForce, bool dedans, std::optional<Utilitaires::EnsembleIds>* temoin) const;
+
+    const SystemeArgumentation& sa_;
+    bool applicable_ = false;
+    int largeur_ = 0;
+    std::vector<int> ordre_;  // Ordre d'élimination : le sac de ordre_[k] est traité après ceux de ses enfants
+    // separateurs_[v] : voisins de v encore présents à son élimination ; le sac de v est {v} ∪ separateurs_[v]
+    std::vector<std::vector<int>> separateurs_;
+    std::vector<std::vector<int>> enfants_;  // Sacs dont le parent est celui de v
+    std::vector<int> racines_;  // Un sac racine (séparateur vide) par composante connexe
+};
+
+#endif // DECOMPOSITION_ARBORESCENTE_HPP
@@ -0,0 +1,38 @@
+/* GrandEntier.hpp
+ * Entier naturel de précision arbitraire pour les comptages d'extensions : la valeur reste un entier 64 bits tant
+ * qu'elle y tient et ne passe en chiffres de 32 bits qu'au premier dépassement. */
+
+#ifndef GRAND_ENTIER_HPP
+#define GRAND_ENTIER_HPP
+
+#include <cstdint>  // uint32_t, uint64_t
+#include <string>  // std::string
+#include <vector>  // std::vector
+
+
+class GrandEntier {
+public:
+    GrandEntier(uint64_t valeur = 0) : petit_(valeur) {}
+
+    GrandEntier& operator+=(const GrandEntier& autre);
+    GrandEntier& operator*=(const GrandEntier& autre);
+    friend GrandEntier operator+(GrandEntier a, const GrandEntier& b) { return a += b; }
+    friend GrandEntier operator*(GrandEntier a, const GrandEntier& b) { return a *= b; }
+    bool operator==(const GrandEntier& autre) const;
+    bool operator!=(const GrandEntier& autre) const { return !(*this == autre); }
+
+    bool estNul() const { return chiffres_.empty() && petit_ == 0; }
+    // Représentation décimale
+    std::string versChaine() const;
+
+private:
+    // Chiffres en base 2^32, poids faible en tête, sans zéro de tête (vide tant que la valeur tient dans petit_)
+    std::vector<uint32_t> versChiffres() const;
+    // Range les chiffres, en revenant à la forme 64 bits si possible
+    void depuisChiffres(std::vector<uint32_t> chiffres);
+
+    uint64_t petit_;
+    std::vector<uint32_t> chiffres_;
+};
+
+#endif // GRAND_ENTIER_HPP
@@ -0,0 +1,110 @@
+/* NoyauCompact.hpp
+ * Moteur spécialisé pour les petits systèmes d'argumentation : la borne sur le nombre d'arguments est un paramètre
+ * template, les ensembles sont des tableaux de mots de 64 bits alloués sur la pile et chaque ligne d'attaque est un
+ * masque de bits. La propagation se fait par ET/OU bit à bit et popcount. */
+
+#ifndef NOYAU_COMPACT_HPP
+#define NOYAU_COMPACT_HPP
+
+#include <array>  // std::array
+#include <cstdint>  // uint64_t
+#include <cstddef>  // size_t
+#include <optional>  // std::optional
+#include "SystemeArgumentation.hpp"
+#include "Utilitaires.hpp"
+
+
+// Noyau de résolution pour au plus 64 * NbMots arguments
+template <size_t NbMots>
+class NoyauCompact {
+public:
+    // Nombre maximal d'arguments représentables par cette instanciation
+    static constexpr size_t CAPACITE = 64 * NbMots;
+    // Ensemble d'arguments : le bit i du mot i / 64 est à 1 si l'argument i appartient à l'ensemble
+    using Ensemble = std::array<uint64_t, NbMots>;
+
+    // Construit les masques d'attaques à partir du système (qui doit contenir au plus CAPACITE arguments)
+    explicit NoyauCompact(const SystemeArgumentation& sa);
+
+    // Les témoins optionnels reçoivent l'ensemble issu de la recherche qui a produit la réponse : extension trouvée
+    // (DC, existence), contre-exemple (DS) ou sur-ensemble admissible strict (VE-PR), sans recherche supplémentaire
+    // Un argument hors de toute extension est réfuté en DS par n'importe laquelle, qu'il faut alors chercher ; en
+    // stable, il n'y a pas de témoin s'il n'existe aucune extension
+
+    // Vérification VE
+    bool verifierStable(const Utilitaires::EnsembleIds& S) const;
+    bool verifierPreferee(const Utilitaires::EnsembleIds& S,
+                          std::optional<Utilitaires::EnsembleIds>* temoin = nullptr) const;
+
+    // Decision Credulous DC
+    bool credulousStable(int argId, std::optional<Utilitaires::EnsembleIds>* temoin = nullptr) const;
+    bool credulousPreferred(int argId, std::optional<Utilitaires::EnsembleIds>* temoin = nullptr) const;
+
+    // Decision Skeptical DS
+    bool skepticalStable(int argId, std::optional<Utilitaires::EnsembleIds>* temoin = nullptr) const;
+    bool skepticalPreferred(int argId, std::optional<Utilitaires::EnsembleIds>* temoin = nullptr) const;
+
+    // Existence d'au moins une extension stable
+    bool existeStable(std::optional<Utilitaires::EnsembleIds>* temoin = nullptr) const;
+    // Une extension préférée, obtenue en étendant l'ensemble vide
+    Utilitaires::EnsembleIds extensionPreferee() const;
+
+private:
+    // Recherche une extension stable contenant in, évitant out, avec couverts = arguments attaqués par in
+    // L'extension trouvée est écrite dans trouve
+    bool chercherStable(Ensemble in, Ensemble out, Ensemble couverts, Ensemble& trouve) const;
+    // Recherche un ensemble admissible contenant in et disjoint de exclus, résultat écrit dans trouve
+    // Si aQuitter est non nul, l'ensemble doit en plus n'être inclus dans aucun des nbAQuitter ensembles donnés
+    bool chercherAdmissible(Ensemble in, Ensemble exclus, Ensemble& trouve,
+                            const Ensemble* aQuitter = nullptr, size_t nbAQuitter = 0) const;
+    // Étend un ensemble admissible en une extension préférée, en essayant l'argument dernier en dernier
+    // Les arguments de exclus ne sont pas essayés : l'extension est alors préférée dans le reste du système
+    Ensemble etendreEnPreferee(Ensemble S, int dernier, Ensemble exclus = Ensemble{}) const;
+    // Ancêtres de argId (lui compris) : aucun argument extérieur n'attaque cet ensemble
+    Ensemble ancetres(int argId) const;
+    // Convertit une liste d'identifiants en ensemble
+    Ensemble versEnsemble(const Utilitaires::EnsembleIds& S) const;
+    // Convertit un ensemble en liste triée d'identifiants
+    static Utilitaires::EnsembleIds versIds(const Ensemble& e);
+
+    size_t n_;  // Nombre d'arguments effectifs
+    Ensemble tous_;  // Masque des n_ arguments
+    Ensemble autoAttaques_;  // Arguments qui s'attaquent eux-mêmes
+    std::array<Ensemble, CAPACITE> cibles_;  // cibles_[i] : arguments attaqués par i
+    std::array<Ensemble, CAPACITE> attaquants_;  // attaquants_[i] : arguments qui attaquent i
+};
+
+// Les trois instanciations sont compilées une seule fois dans NoyauCompact.cpp
+extern template class NoyauCompact<1>;
+extern template class NoyauCompact<2>;
+extern template class NoyauCompact<4>;
+
+
+// Sélection à l'exécution de la plus petite instanciation adaptée au système
+namespace NoyauxCompacts {
+    // Au-delà de cette taille, on revient au moteur générique de Semantiques
+    constexpr size_t CAPACITE_MAX = NoyauCompact<4>::CAPACITE;
+
+    // Vérifie si le système est assez petit pour un noyau compact
+    inline bool estApplicable(const SystemeArgumentation& sa) {
+        return sa.getNbArguments() <= CAPACITE_MAX;
+    }
+
+    // Construit le plus petit noyau pouvant contenir le système (sur la pile) et lui applique la fonction donnée
+    template <typename Fonction>
+    bool appliquer(const SystemeArgumentation& sa, Fonction&& fonction) {
+        size_t n = sa.getNbArguments();
+        if (n <= NoyauCompact<1>::CAPACITE) {
+            const NoyauCompact<1> noyau(sa);
+            return fonction(noyau);
+        }
+        if (n <= NoyauCompact<2>::CAPACITE) {
+            const NoyauCompact<2> noyau(sa);
+            return fonction(noyau);
+        }
+        const NoyauCompact<4> noyau(sa);
+        return fonction(noyau);
+    }
+}
+
+#endif // NOYAU_COMPACT_HPP
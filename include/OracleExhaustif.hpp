@@ -0,0 +1,54 @@
+/* OracleExhaustif.hpp
+ * Moteur exhaustif pour les très petits systèmes (au plus 32 arguments) : tous les sous-ensembles sont parcourus sous
+ * forme de masques de 32 bits, répartis entre threads, et une seule passe donne toutes les extensions et toutes les
+ * réponses DC/DS. Indépendant de la simplification et des moteurs de recherche, il sert de référence pour les tester. */
+
+#ifndef ORACLE_EXHAUSTIF_HPP
+#define ORACLE_EXHAUSTIF_HPP
+
+#include <cstddef>  // size_t
+#include <cstdint>  // uint32_t, uint64_t
+#include <ostream>  // std::ostream
+#include <vector>  // std::vector
+#include "SystemeArgumentation.hpp"
+#include "Solveur.hpp"
+
+
+namespace OracleExhaustif {
+    // Nombre maximal d'arguments (un bit par argument dans un mot de 32 bits)
+    constexpr size_t CAPACITE = 32;
+    // Ensemble d'arguments : le bit i est à 1 si l'argument d'identifiant i appartient à l'ensemble
+    using Masque = uint32_t;
+
+    // Résultat de l'énumération : toutes les extensions et, par tâche, le masque des arguments acceptés
+    struct Bilan {
+        size_t nbArguments = 0;
+        uint64_t nbAdmissibles = 0;  // Nombre d'ensembles admissibles (ils ne sont pas conservés)
+        std::vector<Masque> completes;  // Extensions complètes, triées par masque croissant
+        std::vector<Masque> preferees;  // Complètes maximales pour l'inclusion
+        std::vector<Masque> stables;
+        Masque fondee = 0;  // Plus petite complète, intersection de toutes
+        Masque credulePreferee = 0;  // Union des préférées (DC-PR, DC-CO)
+        Masque sceptiquePreferee = 0;  // Intersection des préférées (DS-PR)
+        Masque creduleStable = 0;  // Union des stables (DC-ST)
+        Masque sceptiqueStable = 0;  // Intersection des stables, vide s'il n'y en a aucune (DS-ST)
+    };
+
+    // Vrai si le système a au plus CAPACITE arguments
+    bool estApplicable(const SystemeArgumentation& sa);
+
+    // Parcourt les 2^n sous-ensembles sur nbThreads threads (0 : un par cœur)
+    Bilan enumerer(const SystemeArgumentation& sa, size_t nbThreads = 0);
+
+    // Réponse à une tâche YES/NO : requete est l'ensemble à vérifier (VE) ou l'argument seul (DC/DS)
+    bool repondre(const Bilan& bilan, TypeProbleme probleme, Masque requete);
+    // Nombre d'extensions d'une tâche CE, ou de celles qui contiennent requete s'il est non vide
+    uint64_t compter(const Bilan& bilan, TypeProbleme probleme, Masque requete = 0);
+
+    // Convertit un masque en liste d'identifiants triée
+    std::vector<int> versIds(Masque masque);
+    // Écrit le rapport complet : extensions de chaque sémantique puis arguments acceptés pour chaque tâche DC/DS
+    void afficher(const Bilan& bilan, const SystemeArgumentation& sa, std::ostream& sortie);
+}
+
+#endif // ORACLE_EXHAUSTIF_HPP
@@ -1,10 +1,14 @@
 /* Parseur.hpp
- * Module responsable de l'analyse syntaxique des fichiers .apx pour construire le système d'argumentation. */
+ * Module responsable de l'analyse syntaxique des fichiers .apx (ou au format numérique "p af N") pour construire le
+ * système d'argumentation. */
 
 #ifndef PARSEUR_HPP
 #define PARSEUR_HPP
 
+#include <istream>  // std::istream
 #include <string>  // std::string
+#include <string_view>  // std::string_view
+#include <utility>  // std::pair
 #include <stdexcept>  // std::runtime_error
 #include "SystemeArgumentation.hpp"
 
@@ -19,20 +23,43 @@ public:
 class Parseur {
 public:
     // Point d'entrée principal : lit un fichier et retourne l'objet SystemeArgumentation construit
+    // Le chemin "-" désigne l'entrée standard, lue au fil de l'eau par parserDescripteur
     // Lance une exception ErreurParsing si le fichier est invalide
     static SystemeArgumentation parserFichier(const std::string& cheminFichier);
+    // Analyse un contenu déjà en mémoire, nomSource sert uniquement aux messages d'erreur
+    // Au-delà de quelques mégaoctets, un contenu .apx est découpé en blocs analysés en parallèle
+    static SystemeArgumentation parserTampon(std::string_view contenu, const std::string& nomSource);
+    // Analyse un flux pendant sa lecture : un thread lit des blocs de taille fixe dans une file bornée pendant que
+    // les lignes complètes sont analysées, leurs arguments résolus et les degrés comptés ; seules les listes
+    // d'attaques restent à remplir à la fin du flux. Le format (.apx ou numérique) est reconnu à la première ligne
+    static SystemeArgumentation parserFlux(std::istream& flux, const std::string& nomSource);
+    // Même analyse sur un descripteur de fichier (tube, entrée standard) : à la première erreur, la lecture est
+    // abandonnée sans attendre la suite du flux, ce qu'un std::istream bloqué dans une lecture ne permet pas
+    static SystemeArgumentation parserDescripteur(int descripteur, const std::string& nomSource);
+    // Vérifie si un nom d'argument est valide (càd lettres, chiffres, underscore, pas arg ni att)
+    static bool estNomValide(std::string_view nom);
 
 private:
+    // Résultat de l'analyse d'un bloc de lignes (défini dans Parseur.cpp)
+    struct BlocAnalyse;
+    // Analyse incrémentale d'un flux, ligne par ligne, dans l'un ou l'autre format (défini dans Parseur.cpp)
+    struct AnalyseFlux;
+    // Thread de lecture d'un flux ou d'un descripteur en blocs de taille fixe (défini dans Parseur.cpp)
+    class LecteurFlux;
+    // Boucle commune à parserFlux et parserDescripteur : analyse les blocs du lecteur puis finalise le système
+    static SystemeArgumentation analyserFlux(LecteurFlux& lecteur, const std::string& nomSource);
+    // Analyse toutes les lignes d'un bloc et remplit ses tampons d'arguments et d'attaques
+    // S'arrête à la première ligne invalide, dont le numéro (local au bloc) et le message sont conservés
+    static void analyserBloc(std::string_view bloc, BlocAnalyse& resultat);
+
     // Analyse une ligne déclarant un argument via arg(x). et extrait le nom x
     // Retourne le nom de l'argument extrait et lance une exception si format invalide
-    static std::string parserLigneArgument(const std::string& ligne);
+    static std::string_view parserLigneArgument(std::string_view ligne);
     // Analyse une ligne déclarant une attaque via att(x,y). et extrait la paire {x, y}
     // Retourne une paire (source, cible) et lance une exception si format invalide
-    static std::pair<std::string, std::string> parserLigneAttaque(const std::string& ligne);
-    // Vérifie si un nom d'argument est valide (càd lettres, chiffres, underscore, pas arg ni att)
-    static bool estNomValide(const std::string& nom);
+    static std::pair<std::string_view, std::string_view> parserLigneAttaque(std::string_view ligne);
     // Supprime les espaces en début et fin de chaîne
-    static std::string trim(const std::string& str);
+    static std::string_view trim(std::string_view str);
 };
 
 #endif // PARSEUR_HPP
@@ -0,0 +1,42 @@
+/* RechercheLocale.hpp
+ * Recherche locale stochastique d'extensions stables, dans le style de WalkSAT : un labelling IN/OUT complet est
+ * corrigé bascule par bascule jusqu'à ne plus violer aucune contrainte. Incomplète, elle ne prouve jamais qu'aucune
+ * extension n'existe et s'arrête au bout d'un budget de bascules ; elle sert de première tentative rapide avant la
+ * recherche systématique, sur les grands systèmes qui ont des extensions stables. */
+
+#ifndef RECHERCHE_LOCALE_HPP
+#define RECHERCHE_LOCALE_HPP
+
+#include <cstdint>  // uint64_t
+#include <optional>  // std::optional
+#include "SystemeArgumentation.hpp"
+#include "Utilitaires.hpp"
+
+
+namespace RechercheLocale {
+    // Réglages communs à toutes les requêtes du processus
+    struct Parametres {
+        uint64_t bascules = 10000000;  // Budget de bascules par requête (0 : recherche locale désactivée)
+        // Budget, plafonné par bascules, de la recherche d'un contre-exemple DS-ST (0 : pas de tentative) : quand
+        // l'argument est accepté de manière sceptique, la marche ne peut qu'épuiser ce budget avant la recherche complète
+        uint64_t basculesContreExemple = 100000;
+        uint64_t basculesParEssai = 0;  // Bascules avant de repartir d'un nouveau labelling (0 : 100 par argument,
+                                        // au moins un million)
+        double bruit = 0.4;  // Probabilité de basculer un candidat au hasard quand aucun ne corrige sans casser
+        uint64_t graine = 1;  // Graine du générateur, combinée à la requête pour des résultats reproductibles
+    };
+
+    // Remplace les réglages ; à appeler avant de lancer les requêtes, les threads de recherche les lisent sans verrou
+    void configurer(const Parametres& parametres);
+    // Réglages courants
+    const Parametres& parametres();
+
+    // Cherche une extension stable contenant argument et sans exclu (chacun ignoré s'il est négatif)
+    // Le budget est celui des contre-exemples DS-ST quand exclu est donné, bascules sinon
+    // Retourne l'extension triée, contrôlée par Semantiques::verifierStable, ou std::nullopt si le budget s'épuise
+    // Les limites du Budget du thread sont vérifiées à chaque bascule
+    std::optional<Utilitaires::EnsembleIds> chercherStable(const SystemeArgumentation& sa, int argument = -1,
+                                                           int exclu = -1);
+}
+
+#endif // RECHERCHE_LOCALE_HPP
@@ -0,0 +1,32 @@
+/* Reordonnancement.hpp
+ * Renumérotation des arguments après le chargement : les voisins d'un argument reçoivent des identifiants proches,
+ * ce qui resserre les accès aux listes d'attaques et aux tableaux de labels pendant la recherche. */
+
+#ifndef REORDONNANCEMENT_HPP
+#define REORDONNANCEMENT_HPP
+
+#include <vector>  // std::vector
+#include <string>  // std::string
+#include "SystemeArgumentation.hpp"
+
+
+// Ordre des identifiants internes
+enum class OrdreArguments {
+    DECLARATION,  // Ordre du fichier, aucune renumérotation
+    RCM,          // Cuthill-McKee inverse sur le graphe non orienté : réduit la largeur de bande de l'adjacence
+    TOPOLOGIQUE   // Composantes fortement connexes dans l'ordre topologique (attaquants d'abord), largeur dans chacune
+};
+
+namespace Reordonnancement {
+    // Convertit un nom d'ordre ("declaration", "rcm", "scc"), retourne false s'il est inconnu
+    bool lireOrdre(const std::string& nom, OrdreArguments& ordre);
+
+    // Calcule la permutation associée à l'ordre : nouvelId[i] est le nouvel identifiant de l'argument i
+    std::vector<int> calculerPermutation(const SystemeArgumentation& sa, OrdreArguments ordre);
+
+    // Renumérote le système selon l'ordre (sans effet pour DECLARATION)
+    // Les noms restent attachés à leurs arguments et l'affichage suit toujours l'ordre de déclaration
+    void reordonner(SystemeArgumentation& sa, OrdreArguments ordre);
+}
+
+#endif // REORDONNANCEMENT_HPP
@@ -4,29 +4,53 @@
 #ifndef SEMANTIQUES_HPP
 #define SEMANTIQUES_HPP
 
+#include <vector>  // std::vector
+#include <optional>  // std::optional
 #include "SystemeArgumentation.hpp"
 #include "Utilitaires.hpp"
 
 
+// Statut d'un argument dans le labelling fondé
+enum class LabelFonde { UNDEC, IN, OUT };
+
+// Les témoins optionnels reçoivent l'ensemble lu dans l'état de la recherche qui a produit la réponse
 class Semantiques {
 public:
     // Vérification VE
     // Vérifie si S est une extension stable
     static bool verifierStable(const Utilitaires::EnsembleIds& S, const SystemeArgumentation& sa);
-    // Vérifie si S est une extension préférée
-    static bool verifierPreferee(const Utilitaires::EnsembleIds& S, const SystemeArgumentation& sa);
+    // Vérifie si S est une extension préférée (témoin si non : sur-ensemble admissible strict)
+    static bool verifierPreferee(const Utilitaires::EnsembleIds& S, const SystemeArgumentation& sa,
+                                 std::optional<Utilitaires::EnsembleIds>* temoin = nullptr);
 
     // Decision Credulous DC
-    // Acceptabilité crédule pour la sémantique stable
-    static bool credulousStable(int argId, const SystemeArgumentation& sa);
-    // Acceptabilité crédule pour la sémantique préférée
-    static bool credulousPreferred(int argId, const SystemeArgumentation& sa);
+    // Acceptabilité crédule pour la sémantique stable (témoin si oui : extension stable contenant argId)
+    static bool credulousStable(int argId, const SystemeArgumentation& sa,
+                                std::optional<Utilitaires::EnsembleIds>* temoin = nullptr);
+    // Acceptabilité crédule pour la sémantique préférée (témoin si oui : ensemble admissible contenant argId)
+    static bool credulousPreferred(int argId, const SystemeArgumentation& sa,
+                                   std::optional<Utilitaires::EnsembleIds>* temoin = nullptr);
 
     // Decision Skeptical DS
-    // Acceptabilité sceptique pour la sémantique stable
-    static bool skepticalStable(int argId, const SystemeArgumentation& sa);
-    // Acceptabilité sceptique pour la sémantique préférée
-    static bool skepticalPreferred(int argId, const SystemeArgumentation& sa);
+    // Acceptabilité sceptique pour la sémantique stable (témoin si non : extension stable sans argId, absent s'il
+    // n'existe aucune extension stable)
+    static bool skepticalStable(int argId, const SystemeArgumentation& sa,
+                                std::optional<Utilitaires::EnsembleIds>* temoin = nullptr);
+    // Acceptabilité sceptique pour la sémantique préférée (témoin si non : extension maximale sans argId)
+    static bool skepticalPreferred(int argId, const SystemeArgumentation& sa,
+                                   std::optional<Utilitaires::EnsembleIds>* temoin = nullptr);
+
+    // Existence d'au moins une extension stable (témoin si oui : l'extension trouvée)
+    static bool existeStable(const SystemeArgumentation& sa,
+                             std::optional<Utilitaires::EnsembleIds>* temoin = nullptr);
+    // Une extension préférée, obtenue en étendant l'ensemble vide, triée
+    static Utilitaires::EnsembleIds extensionPreferee(const SystemeArgumentation& sa);
+
+    // Sémantique fondée GR
+    // Labelling fondé calculé en O(n + m) par compteurs d'attaquants et file
+    static std::vector<LabelFonde> labellingFonde(const SystemeArgumentation& sa);
+    // Extension fondée (arguments IN du labelling fondé), triée
+    static Utilitaires::EnsembleIds extensionFondee(const SystemeArgumentation& sa);
 };
 
 #endif // SEMANTIQUES_HPP
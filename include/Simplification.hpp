@@ -0,0 +1,59 @@
+/* Simplification.hpp
+ * Prétraitement réduisant le système d'argumentation avant la résolution : retrait de l'extension fondée et des
+ * arguments qu'elle attaque, noyaux stable/admissible, retrait des auto-attaquants sans effet et fusion des clones
+ * (arguments ayant les mêmes attaquants et les mêmes cibles). */
+
+#ifndef SIMPLIFICATION_HPP
+#define SIMPLIFICATION_HPP
+
+#include <vector>  // std::vector
+#include <ostream>  // std::ostream
+#include "SystemeArgumentation.hpp"
+
+
+// Sémantique pour laquelle la simplification doit préserver les extensions
+enum class SemantiqueCible {
+    STABLE,   // Noyau stable, les auto-attaquants sont conservés (ils doivent être attaqués)
+    PREFEREE  // Noyau admissible, les auto-attaquants sans autre cible sont retirés
+};
+
+// Devenir d'un argument du système original
+enum class StatutSimplifie {
+    CONSERVE,  // Présent dans le système réduit
+    ACCEPTE,   // Dans l'extension fondée, donc dans toute extension
+    REJETE     // Dans aucune extension (attaqué par l'extension fondée ou auto-attaquant retiré)
+};
+
+// Bilan de la réduction
+struct StatistiquesSimplification {
+    size_t argumentsInitiaux = 0;
+    size_t attaquesInitiales = 0;
+    size_t argumentsAcceptes = 0;  // Extension fondée
+    size_t argumentsRejetes = 0;  // Attaqués par l'extension fondée
+    size_t autoAttaquantsRetires = 0;
+    size_t attaquesNoyau = 0;  // Attaques redondantes retirées par le noyau
+    size_t clonesFusionnes = 0;  // Arguments représentés par un clone dans le système réduit
+    size_t argumentsRestants = 0;
+    size_t attaquesRestantes = 0;
+};
+
+// Résultat de la simplification : système réduit et correspondance avec les identifiants originaux
+struct SystemeSimplifie {
+    SystemeArgumentation systeme;  // Système réduit (les noms sont ceux du système original)
+    std::vector<int> versOriginal;  // versOriginal[idReduit] : identifiant original (le représentant des clones)
+    // versReduit[idOriginal] : identifiant réduit, -1 si l'argument a été retiré
+    // Les clones partagent l'identifiant réduit de leur représentant : ils sont tous dans une extension ou aucun
+    std::vector<int> versReduit;
+    std::vector<StatutSimplifie> statuts;  // Statut de chaque argument original
+    StatistiquesSimplification statistiques;
+};
+
+namespace Simplification {
+    // Construit un système réduit ayant les mêmes extensions (à l'extension fondée près) pour la sémantique donnée
+    SystemeSimplifie simplifier(const SystemeArgumentation& sa, SemantiqueCible semantique);
+
+    // Affiche le bilan de la réduction (une ligne par compteur)
+    void afficherStatistiques(const StatistiquesSimplification& stats, std::ostream& os);
+}
+
+#endif // SIMPLIFICATION_HPP
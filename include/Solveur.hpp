@@ -1,12 +1,24 @@
 /* Solveur.hpp
- * Interface faisant le pont entre les requêtes utilisateur et les algorithmes de sémantiques. */
+ * Interface faisant le pont entre les requêtes utilisateur et les algorithmes de sémantiques. Un Solveur est une
+ * session sur un système : les structures dérivées sont construites à la première requête qui en a besoin puis
+ * gardées, et chaque ensemble trouvé par une recherche est retenu pour répondre aux requêtes suivantes. */
 
 #ifndef SOLVEUR_HPP
 #define SOLVEUR_HPP
 
+#include <cstdint>  // int8_t
+#include <mutex>  // std::mutex
 #include <vector>  // std::vector
 #include <string>  // std::string
+#include <optional>  // std::optional
+#include <unordered_map>  // std::unordered_multimap
 #include "SystemeArgumentation.hpp"
+#include "Simplification.hpp"
+#include "ClassesGraphe.hpp"
+#include "DecompositionArborescente.hpp"
+#include "GrandEntier.hpp"
+#include "Semantiques.hpp"
+#include "Utilitaires.hpp"
 
 // Enumération pour identifier le type de tâche demandée
 enum class TypeProbleme {
@@ -15,37 +27,140 @@ enum class TypeProbleme {
     DS_PR,  // Decide Skeptical - Preferred
     VE_ST,  // Verify Extension - Stable
     DC_ST,  // Decide Credulous - Stable
-    DS_ST   // Decide Skeptical - Stable
+    DS_ST,  // Decide Skeptical - Stable
+    DC_GR,  // Decide Credulous - Grounded
+    DS_GR,  // Decide Skeptical - Grounded
+    SE_GR,  // Some Extension - Grounded
+    SE_ST,  // Some Extension - Stable
+    DC_CO,  // Decide Credulous - Complete
+    DS_CO,  // Decide Skeptical - Complete
+    CE_ST,  // Count Extensions - Stable
+    CE_PR   // Count Extensions - Preferred
 };
 
 class Solveur {
 public:
-    // Constructeur pour garder une référence vers le système
+    // Ensemble d'arguments justifiant une réponse, lu dans l'état de la recherche qui l'a produite :
+    // extension trouvée pour un oui en DC, contre-exemple pour un non en DS, sur-ensemble admissible strict en VE-PR
+    // Vide (std::nullopt) si la réponse n'est pas issue d'une recherche ayant abouti à un ensemble
+    using Temoin = std::optional<std::vector<std::string>>;
+
+    // Constructeur pour garder une référence vers le système, dont la classe structurelle est calculée une fois ici
+    // Le système ne doit plus être modifié pendant la vie du solveur, dont les caches le supposent figé
+    // Les requêtes peuvent être faites depuis plusieurs threads : l'accès aux caches est protégé par un verrou
     explicit Solveur(const SystemeArgumentation& sa);
+    Solveur(const Solveur&) = delete;
+    Solveur& operator=(const Solveur&) = delete;
+
+    // Les paramètres temoin sont optionnels : sans eux, aucun ensemble n'est conservé
 
     // Vérifie si l'ensemble d'arguments est une extension préférée
-    bool verifierExtensionPreferee(const std::vector<std::string>& ensembleNoms) const;
+    bool verifierExtensionPreferee(const std::vector<std::string>& ensembleNoms, Temoin* temoin = nullptr) const;
     // Vérifie si l'ensemble est une extension stable
     bool verifierExtensionStable(const std::vector<std::string>& ensembleNoms) const;
 
     // Détermine si l'argument donné appartient à au moins une extension préférée
-    bool acceptationCredulePreferee(const std::string& arg) const;
+    bool acceptationCredulePreferee(const std::string& arg, Temoin* temoin = nullptr) const;
     // Détermine si l'argument donné appartient à au moins une extension stable
-    bool acceptationCreduleStable(const std::string& arg) const;
+    bool acceptationCreduleStable(const std::string& arg, Temoin* temoin = nullptr) const;
 
     // Détermine si l'argument donné appartient à toutes les extensions préférées
-    bool acceptationSceptiquePreferee(const std::string& arg) const;
+    bool acceptationSceptiquePreferee(const std::string& arg, Temoin* temoin = nullptr) const;
     // Détermine si l'argument donné appartient à toutes les extensions stables
-    bool acceptationSceptiqueStable(const std::string& arg) const;
+    bool acceptationSceptiqueStable(const std::string& arg, Temoin* temoin = nullptr) const;
+
+    // Détermine si l'argument donné appartient à l'extension fondée (acceptations DC/DS-GR et DS-CO)
+    // Le témoin est l'extension fondée elle-même
+    bool acceptationFondee(const std::string& arg, Temoin* temoin = nullptr) const;
+    // Retourne les noms des arguments de l'extension fondée, dans l'ordre de déclaration
+    std::vector<std::string> extensionFondee() const;
+    // Retourne une extension stable, ou std::nullopt s'il n'en existe aucune
+    Temoin extensionStable() const;
+
+    // Nombre d'extensions pour une tâche CE, ou nombre de celles qui contiennent argument s'il est non vide
+    // (le rapport des deux donne la proportion d'extensions qui acceptent l'argument)
+    GrandEntier compterExtensions(TypeProbleme probleme, const std::string& argument = "") const;
+
+    // Retourne la classe structurelle du système (les requêtes sur une classe polynomiale évitent la recherche)
+    const ClassificationGraphe& classification() const;
+
+    // Retourne le bilan de la simplification appliquée avant la résolution pour la sémantique donnée
+    StatistiquesSimplification statistiquesSimplification(SemantiqueCible semantique) const;
+    // Système simplifié sur lequel la dernière requête a travaillé (en stable pour une tâche préférée sur un système
+    // cohérent), ou nul si aucune requête n'en a eu besoin
+    const SystemeSimplifie* derniereSimplification() const;
+
+    // Convertit un nom de tâche ("VE-PR", "DC-ST"...) en TypeProbleme, retourne false si le nom est inconnu
+    static bool lireTypeProbleme(const std::string& nom, TypeProbleme& probleme);
+    // Vrai pour les tâches VE, qui portent sur un ensemble d'arguments plutôt que sur un seul
+    static bool estVerification(TypeProbleme probleme);
+    // Vrai pour les tâches CE, qui produisent un nombre plutôt qu'une réponse YES/NO
+    static bool estComptage(TypeProbleme probleme);
 
     // Appelle la bonne méthode selon le TypeProbleme
+    // Le témoin n'est conservé que s'il justifie la réponse (oui en DC et SE-ST, non en DS et VE)
     bool resoudre(TypeProbleme probleme,
                   const std::vector<std::string>& ensembleArgs,
-                  const std::string& argument) const;
+                  const std::string& argument,
+                  Temoin* temoin = nullptr) const;
 
 private:
+    // Tâches de décision dont les réponses sont retenues d'une requête à l'autre (DC-CO suit DC-PR)
+    enum class TacheRetenue { DC_PR, DC_ST, DS_PR, DS_ST };
+    static constexpr size_t NB_TACHES_RETENUES = 4;
+    // Ce qu'un ensemble trouvé prouve : admissible (membres crédules en préférée), préférée (autres arguments non
+    // sceptiques en préférée en plus), stable (mêmes conclusions en stable, puisqu'une stable est préférée)
+    enum class NatureEnsemble { ADMISSIBLE, PREFEREE, STABLE };
+
+    // Faits appris au fil des requêtes, en identifiants originaux
+    struct Connaissances {
+        std::vector<int8_t> reponses[NB_TACHES_RETENUES];  // Par argument : -1 inconnue, 0 non, 1 oui
+        std::vector<int> temoins[NB_TACHES_RETENUES];  // Indice dans ensembles de ce qui justifie la réponse, ou -1
+        std::vector<Utilitaires::EnsembleIds> ensembles;  // Ensembles qui justifient au moins une réponse, triés
+        std::unordered_multimap<uint64_t, int> indices;  // Empreinte de chaque ensemble retenu -> son indice
+        std::vector<bool> marques;  // Appartenance à l'ensemble en cours d'apprentissage, remise à faux après usage
+    };
+
+    // Aiguillage de resoudre vers la méthode de la tâche
+    bool resoudreTache(TypeProbleme probleme, const std::vector<std::string>& ensembleArgs,
+                       const std::string& argument, Temoin* temoin) const;
+
+    // Système simplifié pour la sémantique, calculé à la première requête qui en a besoin
+    const SystemeSimplifie& reduit(SemantiqueCible semantique) const;
+    // Décomposition arborescente du système simplifié, calculée à la première requête qui en a besoin, avec son
+    // applicabilité ; nulle si le système simplifié tient dans un noyau compact
+    const DecompositionArborescente* decomposition(SemantiqueCible semantique) const;
+    // Labelling fondé du système, calculé une fois
+    const std::vector<LabelFonde>& labellingFonde() const;
+    // Arguments acceptables d'un système biparti, calculés une fois
+    const std::vector<bool>& acceptablesBiparti() const;
+
+    // Réponse déjà établie pour l'argument, avec son témoin s'il est demandé et nécessaire ; std::nullopt s'il faut
+    // chercher (réponse inconnue, ou connue sans l'ensemble qui la justifie)
+    std::optional<bool> consulter(TacheRetenue tache, int id, Temoin* temoin) const;
+    // Retient la réponse d'une recherche et tout ce que prouve l'ensemble trouvé, puis le recopie dans le témoin
+    void retenir(TacheRetenue tache, int id, bool reponse, const std::optional<Utilitaires::EnsembleIds>& ensemble,
+                 Temoin* temoin) const;
+    // Déduit d'un ensemble les réponses qu'il justifie ; il n'est conservé que s'il en fixe une nouvelle et qu'il
+    // n'a pas déjà été retenu (verrou tenu par l'appelant)
+    void apprendre(NatureEnsemble nature, const Utilitaires::EnsembleIds& ensemble) const;
+    // Fixe une réponse encore inconnue, ou lui associe un témoin qui lui manquait (verrou tenu par l'appelant)
+    // Retourne true si la réponse ou son témoin vient d'être fixé
+    bool fixer(TacheRetenue tache, int id, bool reponse, int indiceEnsemble) const;
+
     // Référence constante vers le graphe
     const SystemeArgumentation& systeme_;
+    // Classe structurelle du graphe, qui décide des chemins rapides
+    ClassificationGraphe classification_;
+
+    // Caches de la session, remplis à la demande sous le verrou
+    mutable std::mutex verrou_;
+    mutable std::optional<SystemeSimplifie> reduitStable_, reduitPreferee_;
+    mutable const SystemeSimplifie* derniereSimplification_ = nullptr;  // L'un des deux précédents
+    mutable std::optional<DecompositionArborescente> decompositionStable_, decompositionPreferee_;
+    mutable std::optional<std::vector<LabelFonde>> labellingFonde_;
+    mutable std::optional<std::vector<bool>> acceptablesBiparti_;
+    mutable Connaissances connaissances_;
 };
 
 #endif // SOLVEUR_HPP
@@ -0,0 +1,85 @@
+/* SolveurC.h
+ * Interface C stable de libsolveur.so : chargement ou construction d'un système d'argumentation et résolution des
+ * tâches sans passer par un processus ./solveur. Aucune exception ne traverse cette interface, les erreurs sont
+ * signalées par le code de retour et décrites par solveur_derniere_erreur(). */
+
+#ifndef SOLVEUR_C_H
+#define SOLVEUR_C_H
+
+#include <stddef.h>  /* size_t */
+
+#if defined(__GNUC__)
+#define SOLVEUR_API __attribute__((visibility("default")))
+#else
+#define SOLVEUR_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Poignée opaque sur un système d'argumentation. Elle garde d'une requête à l'autre les structures dérivées du système
+ * et les réponses déjà établies, abandonnées à chaque modification. Plusieurs threads peuvent l'interroger en même
+ * temps, mais pas pendant une modification */
+typedef struct SolveurSysteme SolveurSysteme;
+
+/* Codes de retour de solveur_resoudre (mêmes valeurs que les codes de sortie de ./solveur pour INCONNU) */
+#define SOLVEUR_NON 0
+#define SOLVEUR_OUI 1
+#define SOLVEUR_INCONNU 2   /* Limite de temps ou de mémoire atteinte */
+#define SOLVEUR_ERREUR (-1)
+
+/* Crée un système vide, à remplir avec solveur_ajouter_argument et solveur_ajouter_attaque */
+SOLVEUR_API SolveurSysteme* solveur_creer(void);
+/* Charge un fichier .apx, retourne NULL en cas d'erreur */
+SOLVEUR_API SolveurSysteme* solveur_charger_fichier(const char* chemin);
+/* Analyse un contenu .apx déjà en mémoire (taille octets, pas forcément terminé par un zéro), NULL en cas d'erreur */
+SOLVEUR_API SolveurSysteme* solveur_charger_tampon(const char* contenu, size_t taille);
+/* Libère le système (NULL accepté) */
+SOLVEUR_API void solveur_liberer(SolveurSysteme* systeme);
+
+/* Ajoute un argument : 1 s'il est ajouté, 0 s'il existait déjà, SOLVEUR_ERREUR si le nom est invalide */
+SOLVEUR_API int solveur_ajouter_argument(SolveurSysteme* systeme, const char* nom);
+/* Ajoute une attaque : 1 si elle est ajoutée, 0 si elle existait déjà, SOLVEUR_ERREUR si un argument est inconnu */
+SOLVEUR_API int solveur_ajouter_attaque(SolveurSysteme* systeme, const char* source, const char* cible);
+/* Renumérote les arguments pour la localité mémoire ("rcm" : Cuthill-McKee inverse, "scc" : composantes fortement
+ * connexes en ordre topologique, "declaration" : sans effet). Les noms et l'ordre d'affichage sont inchangés.
+ * Retourne SOLVEUR_OUI, ou SOLVEUR_ERREUR si l'ordre est inconnu */
+SOLVEUR_API int solveur_reordonner(SolveurSysteme* systeme, const char* ordre);
+/* Nombre d'arguments du système */
+SOLVEUR_API size_t solveur_nb_arguments(const SolveurSysteme* systeme);
+
+/* Limites appliquées à chaque résolution suivante du thread appelant (0 : pas de limite). La limite de mémoire porte
+ * sur la croissance de la mémoire résidente de tout le processus depuis le début de la résolution : les allocations
+ * des autres threads pendant ce temps comptent aussi */
+SOLVEUR_API void solveur_configurer_budget(double secondesMax, size_t memoireMaxMo);
+
+/* Résout une tâche ("VE-PR", "DC-ST"...) : les tâches VE portent sur les nbArguments arguments donnés, les tâches
+ * DC/DS sur le premier. Retourne SOLVEUR_OUI, SOLVEUR_NON, SOLVEUR_INCONNU ou SOLVEUR_ERREUR */
+SOLVEUR_API int solveur_resoudre(SolveurSysteme* systeme, const char* probleme,
+                                 const char* const* arguments, size_t nbArguments);
+/* Comme solveur_resoudre, et si temoin est non nul y écrit l'ensemble justifiant la réponse au format "a,b,c" (extension
+ * trouvée pour un oui en DC, contre-exemple pour un non en DS ou VE-PR), à libérer avec solveur_liberer_chaine.
+ * *temoin vaut NULL si aucun ensemble ne justifie la réponse (VE-PR d'un ensemble non admissible, argument inconnu, DS-ST
+ * sans aucune extension stable) */
+SOLVEUR_API int solveur_resoudre_temoin(SolveurSysteme* systeme, const char* probleme,
+                                        const char* const* arguments, size_t nbArguments, char** temoin);
+/* Calcule une extension pour une tâche SE ("SE-GR", "SE-ST") et la retourne sous la forme "a,b,c" (chaîne vide si
+ * elle est vide), à libérer avec solveur_liberer_chaine. Retourne NULL en cas d'erreur ou de limite atteinte, et pour
+ * SE-ST s'il n'existe aucune extension stable (solveur_derniere_erreur vaut alors "Aucune extension stable") */
+SOLVEUR_API char* solveur_extension(SolveurSysteme* systeme, const char* probleme);
+/* Compte les extensions pour une tâche CE ("CE-ST", "CE-PR"), ou seulement celles qui contiennent argument s'il est
+ * non NULL. Retourne le nombre en décimal (précision arbitraire), à libérer avec solveur_liberer_chaine, ou NULL en cas
+ * d'erreur ou de limite atteinte */
+SOLVEUR_API char* solveur_compter(SolveurSysteme* systeme, const char* probleme, const char* argument);
+/* Libère une chaîne retournée par la bibliothèque (NULL accepté) */
+SOLVEUR_API void solveur_liberer_chaine(char* chaine);
+
+/* Message de la dernière erreur du thread appelant (chaîne vide s'il n'y en a pas), valide jusqu'au prochain appel */
+SOLVEUR_API const char* solveur_derniere_erreur(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SOLVEUR_C_H */
@@ -5,63 +5,139 @@
 #define SYSTEME_ARGUMENTATION_HPP
 
 #include <string>  // std::string
+#include <string_view>  // std::string_view
 #include <vector>  // std::vector
-#include <unordered_map>  // std::unordered_map
+#include <cstdint>  // uint32_t, uint64_t
 #include <utility>  // std::pair
 #include <iostream>  // std::cout, std::ostream
 
 
+// Octets occupés par chaque structure d'un système, d'après les capacités réservées et non les tailles utilisées
+struct EmpreinteMemoire {
+    size_t arene = 0;
+    size_t debuts = 0;
+    size_t table = 0;
+    size_t adjacence = 0;  // En-têtes des listes compris
+    size_t parents = 0;
+    size_t rangs = 0;
+
+    // Somme de toutes les structures
+    size_t total() const { return arene + debuts + table + adjacence + parents + rangs; }
+};
+
+
 class SystemeArgumentation {
 private:
-    // Associe chaque nom d'argument à un identifiant unique entier
-    std::unordered_map<std::string, int> nomVersId_;
-    // Tableau permettant de retrouver le nom d'un argument à partir de son identifiant entier
-    std::vector<std::string> idVersNom_;
+    // Arène : tous les noms d'arguments concaténés, chaque nom n'est stocké qu'une fois
+    std::string arene_;
+    // debuts_[i] : position du nom de l'argument i dans l'arène (debuts_[n] marque la fin du dernier nom)
+    std::vector<uint32_t> debuts_{0};
+    // Table de hachage à adressage ouvert (sondage linéaire) : identifiant de l'argument ou -1 si la case est libre
+    // Sa taille est une puissance de deux, au moins le double du nombre d'arguments
+    std::vector<int> table_;
     // Graphe des attaques : adjacence_[i] contient la liste des cibles attaquées par l'argument i
     std::vector<std::vector<int>> adjacence_;
     // Graphe inverse : parents_[i] contient la liste des attaquants de l'argument i
     std::vector<std::vector<int>> parents_;
+    // rangs_[i] : rang de déclaration de l'argument i (vide tant que les identifiants suivent l'ordre de déclaration)
+    std::vector<int> rangs_;
+
+    // Recrée la table de hachage à la taille donnée (puissance de deux) et réinsère tous les identifiants
+    void redimensionnerTable(size_t taille);
 
 public:
     SystemeArgumentation() = default;  // Constructeur par défaut
     ~SystemeArgumentation() = default;  // Destructeur par défaut
+    SystemeArgumentation(const SystemeArgumentation&) = default;
+    SystemeArgumentation& operator=(const SystemeArgumentation&) = default;
+    // Déplacement : le système source reste un système vide valide (debuts_ == {0})
+    SystemeArgumentation(SystemeArgumentation&& autre) noexcept;
+    SystemeArgumentation& operator=(SystemeArgumentation&& autre) noexcept;
 
     // Ajoute un nouvel argument au système et lui assigne un identifiant unique
     // Retourne true si l'argument a été ajouté, false s'il existait déjà
-    bool ajouterArgument(const std::string& arg);
+    bool ajouterArgument(std::string_view arg);
+    // Réserve la place pour nbArguments arguments dont les noms totalisent tailleNoms caractères
+    void reserver(size_t nbArguments, size_t tailleNoms = 0);
     // Ajoute une relation d'attaque entre deux arguments existants
     // Retourne true si l'ajout est réussi, false si les arguments n'existent pas ou l'attaque existe déjà
-    bool ajouterAttaque(const std::string& source, const std::string& cible);
+    bool ajouterAttaque(std::string_view source, std::string_view cible);
 
     // Retourne le nombre total d'arguments
     size_t getNbArguments() const;
     // Retourne l'identifiant entier associé à un nom d'argument ou lance une exception si introuvable
-    int getId(const std::string& nom) const;
+    int getId(std::string_view nom) const;
+    // Retourne l'identifiant associé à un nom, ou -1 s'il est inconnu (sans exception)
+    int trouverId(std::string_view nom) const;
     // Retourne le nom de l'argument correspondant à l'identifiant donné
-    const std::string& getNom(int id) const;
+    // La vue pointe dans l'arène : elle est invalidée par l'ajout d'un nouvel argument
+    std::string_view getNom(int id) const;
     // Retourne une référence constante vers le graphe d'adjacence
     const std::vector<std::vector<int>>& getAdjacence() const;
     // Retourne une référence constante vers le graphe des parents
     const std::vector<std::vector<int>>& getParents() const;
 
     // Vérifie si un argument est présent dans le système
-    bool argumentExiste(const std::string& arg) const;
+    bool argumentExiste(std::string_view arg) const;
     // Vérifie si une attaque existe entre deux arguments donnés par leurs noms
-    bool attaqueExiste(const std::string& source, const std::string& cible) const;
+    bool attaqueExiste(std::string_view source, std::string_view cible) const;
     // Vérifie si une attaque existe entre deux arguments donnés par leurs identifiants
     bool attaqueExiste(int idSource, int idCible) const;
-    // Retourne la liste complète des noms des arguments
-    const std::vector<std::string>& getArguments() const;
+    // Construit et retourne la liste complète des noms des arguments, dans l'ordre de déclaration
+    std::vector<std::string> getArguments() const;
     // Construit et retourne la liste de toutes les attaques sous forme de paires de noms
     std::vector<std::pair<std::string, std::string>> getAttaques() const;
     // Retourne la liste des noms des arguments qui attaquent l'argument donné
-    std::vector<std::string> getAttaquants(const std::string& arg) const;
+    std::vector<std::string> getAttaquants(std::string_view arg) const;
     // Retourne la liste des noms des arguments attaqués par l'argument donné
-    std::vector<std::string> getCibles(const std::string& arg) const;
+    std::vector<std::string> getCibles(std::string_view arg) const;
+    // Remplace toutes les attaques par les listes fournies, utilisé par le chargement en bloc
+    // Les deux listes doivent décrire les mêmes arcs, sans doublon, et avoir une entrée par argument
+    void remplacerAttaques(std::vector<std::vector<int>> adjacence, std::vector<std::vector<int>> parents);
+    // Renumérote les arguments : l'argument i prend l'identifiant nouvelId[i] (nouvelId doit être une permutation)
+    // Noms, table de hachage et listes d'attaques suivent, le rang de déclaration est conservé pour l'affichage
+    void renumeroter(const std::vector<int>& nouvelId);
+    // Vrai si les identifiants ne suivent plus l'ordre de déclaration
+    bool estRenumerote() const;
+    // Rang de l'argument dans l'ordre de déclaration (son identifiant si le système n'a pas été renuméroté)
+    int getRangDeclaration(int id) const;
+    // Mesure la mémoire occupée par les structures internes (hors objet lui-même)
+    EmpreinteMemoire empreinteMemoire() const;
     // Réinitialise le système en supprimant tous les arguments et attaques
     void vider();
     // Affiche le contenu du système (pour débug)
     void afficher() const;
 };
 
+
+// Construction en bloc d'un système : les attaques sont accumulées sans contrôle de doublon, puis dédoublonnées
+// une seule fois par tri à la finalisation, qui produit les deux sens d'adjacence en une passe
+class ConstructeurSysteme {
+private:
+    SystemeArgumentation systeme_;  // Arguments déjà enregistrés, attaques encore vides
+    std::vector<std::pair<int, int>> attaques_;  // Attaques (source, cible) en attente, doublons compris
+
+public:
+    // Les tailles prévues servent uniquement à réserver la mémoire
+    explicit ConstructeurSysteme(size_t nbArgumentsPrevus = 0, size_t nbAttaquesPrevues = 0);
+
+    // Réserve la place pour les arguments et attaques à venir
+    void reserver(size_t nbArguments, size_t nbAttaques);
+    // Ajoute un argument s'il n'existe pas encore et retourne son identifiant
+    int ajouterArgument(std::string_view arg);
+    // Ajoute une attaque entre deux arguments existants (les doublons sont éliminés à la finalisation)
+    // Retourne false si l'un des arguments n'existe pas
+    bool ajouterAttaque(std::string_view source, std::string_view cible);
+    // Ajoute une attaque entre deux identifiants déjà attribués
+    void ajouterAttaque(int idSource, int idCible);
+
+    // Retourne le nombre d'arguments enregistrés
+    size_t getNbArguments() const;
+    // Retourne l'identifiant d'un nom, ou -1 s'il est inconnu
+    int trouverId(std::string_view nom) const;
+
+    // Dédoublonne les attaques (tri puis unique) et retourne le système ; le constructeur est ensuite vide
+    SystemeArgumentation finaliser();
+};
+
 #endif // SYSTEME_ARGUMENTATION_HPP
@@ -0,0 +1,42 @@
+/* TraitementLot.hpp
+ * Mode --batch : un fichier de requêtes (tâche, fichier .apx, arguments) est réparti sur un groupe de threads, chaque
+ * système n'étant chargé qu'une fois par le thread qui traite toutes ses requêtes, et les résultats sont écrits au fil
+ * de l'eau dans l'ordre des requêtes. */
+
+#ifndef TRAITEMENT_LOT_HPP
+#define TRAITEMENT_LOT_HPP
+
+#include <cstddef>  // size_t
+#include <ostream>  // std::ostream
+#include <string>  // std::string
+#include "Reordonnancement.hpp"
+
+
+// Format des lignes de résultat
+enum class FormatLot {
+    TSV,   // Colonnes séparées par des tabulations, précédées d'une ligne d'en-tête
+    JSONL  // Un objet JSON par ligne
+};
+
+// Paramètres communs à toutes les requêtes du lot
+struct OptionsLot {
+    size_t nbThreads = 0;  // 0 : un thread par cœur
+    FormatLot format = FormatLot::TSV;
+    bool temoin = false;  // Ajoute le témoin des réponses qui en ont un
+    double limiteSecondes = 0.0;  // Limite de temps par requête (0 : aucune)
+    size_t limiteMo = 0;  // Pic de mémoire résidente du processus (0 : aucune)
+    OrdreArguments ordre = OrdreArguments::DECLARATION;  // Renumérotation appliquée à chaque système chargé
+};
+
+namespace TraitementLot {
+    // Convertit un nom de format ("tsv", "jsonl"), retourne false s'il est inconnu
+    bool lireFormat(const std::string& nom, FormatLot& format);
+
+    // Lit les requêtes (une par ligne : TACHE <tab> FICHIER [<tab> ARGUMENTS], lignes vides et # ignorées), les
+    // regroupe par fichier et écrit une ligne de résultat par requête sur sortie, avec son temps de résolution
+    // Une requête en échec (fichier illisible, tâche inconnue...) produit une réponse ERREUR sans arrêter le lot
+    // Lance une exception si le fichier de requêtes ne peut pas être ouvert
+    void executer(const std::string& cheminRequetes, const OptionsLot& options, std::ostream& sortie);
+}
+
+#endif // TRAITEMENT_LOT_HPP
@@ -0,0 +1,68 @@
+/* AllocateurCompteur.cpp
+ * Remplacement des opérateurs new/delete globaux de l'exécutable : tant que le comptage est inactif, un seul test
+ * s'ajoute à malloc/free ; une fois actif, la taille réelle de chaque bloc est imputée à la phase du thread.
+ * Exclu de la bibliothèque partagée (voir le Makefile) pour ne pas détourner l'allocateur du programme hôte.
+ * Les variantes alignées (std::align_val_t) gardent l'implémentation standard et ne sont pas comptées. */
+
+#include "CompteurMemoire.hpp"
+#include <cstdlib>  // std::malloc, std::free
+#include <new>  // std::bad_alloc, std::nothrow_t
+#ifdef __APPLE__
+#include <malloc/malloc.h>  // malloc_size
+#else
+#include <malloc.h>  // malloc_usable_size
+#endif
+
+
+namespace {
+    // Taille réelle du bloc, identique à l'allocation et à la libération : aucun en-tête n'est nécessaire
+    size_t tailleBloc(void* bloc) {
+#ifdef __APPLE__
+        return malloc_size(bloc);
+#else
+        return malloc_usable_size(bloc);
+#endif
+    }
+
+    // Allocation comptée, nullptr en cas d'échec
+    void* allouer(std::size_t taille) noexcept {
+        void* bloc = std::malloc(taille > 0 ? taille : 1);
+        if (bloc && CompteurMemoire::detail::actif.load(std::memory_order_relaxed)) {
+            CompteurMemoire::detail::enregistrerAllocation(tailleBloc(bloc));
+        }
+        return bloc;
+    }
+
+    // Libération comptée
+    void liberer(void* bloc) noexcept {
+        if (!bloc) return;
+        if (CompteurMemoire::detail::actif.load(std::memory_order_relaxed)) {
+            CompteurMemoire::detail::enregistrerLiberation(tailleBloc(bloc));
+        }
+        std::free(bloc);
+    }
+
+    // Allocation qui appelle le gestionnaire d'échec installé avant d'abandonner, comme l'opérateur standard
+    void* allouerOuLancer(std::size_t taille) {
+        void* bloc;
+        while ((bloc = allouer(taille)) == nullptr) {
+            std::new_handler gestionnaire = std::get_new_handler();
+            if (!gestionnaire) throw std::bad_alloc();
+            gestionnaire();
+        }
+        return bloc;
+    }
+}
+
+
+void* operator new(std::size_t taille) { return allouerOuLancer(taille); }
+void* operator new[](std::size_t taille) { return allouerOuLancer(taille); }
+void* operator new(std::size_t taille, const std::nothrow_t&) noexcept { return allouer(taille); }
+void* operator new[](std::size_t taille, const std::nothrow_t&) noexcept { return allouer(taille); }
+
+void operator delete(void* bloc) noexcept { liberer(bloc); }
+void operator delete[](void* bloc) noexcept { liberer(bloc); }
+void operator delete(void* bloc, std::size_t) noexcept { liberer(bloc); }
+void operator delete[](void* bloc, std::size_t) noexcept { liberer(bloc); }
+void operator delete(void* bloc, const std::nothrow_t&) noexcept { liberer(bloc); }
+void operator delete[](void* bloc, const std::nothrow_t&) noexcept { liberer(bloc); }
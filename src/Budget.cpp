@@ -0,0 +1,88 @@
+/* Budget.cpp
+ * Implémentation des limites de temps et de mémoire. */
+
+#include "Budget.hpp"
+#include <chrono>  // std::chrono::steady_clock
+#include <cstdlib>  // std::strtoull
+#include <fcntl.h>  // open
+#include <sstream>  // std::ostringstream
+#include <sys/resource.h>  // getrusage
+#include <unistd.h>  // sysconf, pread
+
+
+namespace {
+    using Horloge = std::chrono::steady_clock;
+
+    thread_local Horloge::time_point debut = Horloge::now();
+    thread_local double limiteSecondes = 0.0;
+    thread_local size_t limiteMo = 0;
+    thread_local size_t memoireDebutMo = 0;  // Mémoire résidente au démarrage de la requête
+
+    // Pic de mémoire résidente du processus, en mégaoctets
+    size_t picMemoireResidenteMo() {
+        struct rusage usage {};
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return static_cast<size_t>(usage.ru_maxrss) / (1024 * 1024);  // En octets sous macOS
+#else
+        return static_cast<size_t>(usage.ru_maxrss) / 1024;  // En kilooctets sous Linux
+#endif
+    }
+
+    // Mémoire résidente actuelle du processus, en mégaoctets : contrairement au pic, elle redescend quand une requête
+    // précédente libère sa mémoire. Lue dans /proc/self/statm (pages résidentes en deuxième champ), sinon le pic.
+    // Le descripteur est ouvert une seule fois pour tout le processus : pread relit le fichier à chaque appel
+    size_t memoireResidenteMo() {
+        static const int statm = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+        static const size_t taillePage = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        char tampon[128];
+        ssize_t lus = statm < 0 ? -1 : pread(statm, tampon, sizeof(tampon) - 1, 0);
+        if (lus <= 0) return picMemoireResidenteMo();
+        tampon[lus] = '\0';
+        char* fin = nullptr;
+        std::strtoull(tampon, &fin, 10);  // Pages totales, ignorées
+        char* finResidentes = nullptr;
+        size_t pagesResidentes = std::strtoull(fin, &finResidentes, 10);
+        if (finResidentes == fin) return picMemoireResidenteMo();
+        return pagesResidentes * taillePage / (1024 * 1024);
+    }
+}
+
+
+namespace Budget {
+
+void configurer(double secondesMax, size_t memoireMaxMo) {
+    debut = Horloge::now();
+    limiteSecondes = secondesMax;
+    limiteMo = memoireMaxMo;
+    memoireDebutMo = memoireMaxMo > 0 ? memoireResidenteMo() : 0;
+    detail::compteurNoeuds = 0;
+    detail::actif = secondesMax > 0.0 || memoireMaxMo > 0;
+}
+
+Statistiques statistiques() {
+    Statistiques stats;
+    stats.noeuds = detail::compteurNoeuds;
+    stats.secondes = std::chrono::duration<double>(Horloge::now() - debut).count();
+    stats.memoireMo = picMemoireResidenteMo();
+    return stats;
+}
+
+void verifierLimites() {
+    if (limiteSecondes > 0.0) {
+        double ecoule = std::chrono::duration<double>(Horloge::now() - debut).count();
+        if (ecoule >= limiteSecondes) {
+            std::ostringstream message;
+            message << "Limite de temps atteinte (" << limiteSecondes << " s)";
+            throw BudgetEpuise(message.str());
+        }
+    }
+    // Seule compte la croissance depuis configurer() : la mémoire déjà occupée au départ (requêtes précédentes,
+    // système chargé) n'épuise pas le budget. La mesure reste celle du processus entier : en mode lot ou dans la
+    // bibliothèque, ce que les autres threads allouent pendant la requête est compté aussi
+    if (limiteMo > 0 && memoireResidenteMo() >= memoireDebutMo + limiteMo) {
+        throw BudgetEpuise("Limite de mémoire atteinte (" + std::to_string(limiteMo) + " Mo)");
+    }
+}
+
+}
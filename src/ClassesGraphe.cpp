@@ -0,0 +1,251 @@
+/* ClassesGraphe.cpp
+ * Implémentation de la classification structurelle et des procédures polynomiales associées. */
+
+#include "ClassesGraphe.hpp"
+#include "CompteurMemoire.hpp"
+#include <algorithm>  // std::sort, std::min
+#include <queue>  // std::queue
+#include <utility>  // std::pair
+
+
+namespace {
+    using std::vector;
+    using Utilitaires::EnsembleIds;
+
+    // Tente de 2-colorier le graphe non orienté formé par les arcs dont les deux extrémités vérifient garder
+    // Retourne false si une arête relie deux arguments de même couleur (cycle impair)
+    template <typename Garder>
+    bool deuxColorier(const SystemeArgumentation& sa, vector<int>& couleur, Garder&& garder) {
+        const auto& adjacence = sa.getAdjacence();
+        const auto& parents = sa.getParents();
+        size_t n = sa.getNbArguments();
+        couleur.assign(n, -1);
+        std::queue<int> file;
+        for (size_t depart = 0; depart < n; ++depart) {
+            if (couleur[depart] != -1) continue;
+            couleur[depart] = 0;
+            file.push(static_cast<int>(depart));
+            while (!file.empty()) {
+                int u = file.front();
+                file.pop();
+                for (const auto* voisins : {&adjacence[u], &parents[u]}) {
+                    for (int v : *voisins) {
+                        if (!garder(u, v)) continue;
+                        if (couleur[v] == -1) {
+                            couleur[v] = 1 - couleur[u];
+                            file.push(v);
+                        } else if (couleur[v] == couleur[u]) {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    // Plus grand ensemble admissible inclus dans le côté c, parmi les arguments actifs
+    // Un argument du côté c est retiré dès qu'un de ses attaquants (de l'autre côté) n'est plus attaqué par l'ensemble
+    vector<bool> plusGrandAdmissibleCote(const SystemeArgumentation& sa, const vector<int>& cote, int c,
+                                         const vector<bool>& actif) {
+        const auto& adjacence = sa.getAdjacence();
+        const auto& parents = sa.getParents();
+        size_t n = sa.getNbArguments();
+        vector<bool> dansS(n, false);
+        for (size_t i = 0; i < n; ++i) dansS[i] = actif[i] && cote[i] == c;
+
+        // contres[y] : nombre de membres de S qui attaquent y (y actif, de l'autre côté)
+        vector<size_t> contres(n, 0);
+        std::queue<int> nonContres;
+        for (size_t y = 0; y < n; ++y) {
+            if (!actif[y] || cote[y] == c) continue;
+            for (int p : parents[y]) if (dansS[p]) ++contres[y];
+            if (contres[y] == 0) nonContres.push(static_cast<int>(y));
+        }
+        while (!nonContres.empty()) {
+            int y = nonContres.front();
+            nonContres.pop();
+            for (int x : adjacence[y]) {  // y n'est plus contré : ses cibles quittent S
+                if (!dansS[x]) continue;
+                dansS[x] = false;
+                for (int z : adjacence[x]) {
+                    if (actif[z] && cote[z] != c && --contres[z] == 0) nonContres.push(z);
+                }
+            }
+        }
+        return dansS;
+    }
+}
+
+
+std::string ClassificationGraphe::nom() const {
+    if (acyclique) return "acyclique";
+    if (symetrique) return "symétrique";
+    if (biparti) return "bipartie";
+    if (sansCycleImpair) return "sans cycle impair";
+    return "générale";
+}
+
+
+namespace ClassesGraphe {
+
+// Tarjan en version itérative, pour ne pas dépendre de la profondeur de la pile d'appels sur les longues chaînes
+vector<int> composantesFortes(const vector<vector<int>>& adjacence, int& nbComposantes) {
+    size_t n = adjacence.size();
+    vector<int> index(n, -1), bas(n, 0), composante(n, -1);
+    vector<int> pile;
+    vector<bool> surPile(n, false);
+    vector<std::pair<int, size_t>> appels;  // (argument, prochaine cible à visiter)
+    int compteur = 0;
+    nbComposantes = 0;
+
+    for (size_t depart = 0; depart < n; ++depart) {
+        if (index[depart] != -1) continue;
+        appels.emplace_back(static_cast<int>(depart), 0);
+        index[depart] = bas[depart] = compteur++;
+        pile.push_back(static_cast<int>(depart));
+        surPile[depart] = true;
+
+        while (!appels.empty()) {
+            int v = appels.back().first;
+            size_t k = appels.back().second;
+            if (k < adjacence[v].size()) {
+                ++appels.back().second;
+                int w = adjacence[v][k];
+                if (index[w] == -1) {  // Descente vers w
+                    index[w] = bas[w] = compteur++;
+                    pile.push_back(w);
+                    surPile[w] = true;
+                    appels.emplace_back(w, 0);
+                } else if (surPile[w]) {
+                    bas[v] = std::min(bas[v], index[w]);
+                }
+                continue;
+            }
+            // Toutes les cibles de v sont visitées : v est racine de composante si bas[v] == index[v]
+            if (bas[v] == index[v]) {
+                int w;
+                do {
+                    w = pile.back();
+                    pile.pop_back();
+                    surPile[w] = false;
+                    composante[w] = nbComposantes;
+                } while (w != v);
+                ++nbComposantes;
+            }
+            appels.pop_back();
+            if (!appels.empty()) {
+                int parent = appels.back().first;
+                bas[parent] = std::min(bas[parent], bas[v]);
+            }
+        }
+    }
+    return composante;
+}
+
+ClassificationGraphe classifier(const SystemeArgumentation& sa) {
+    CompteurMemoire::PorteePhase phase(CompteurMemoire::Phase::PRETRAITEMENT);
+    const auto& adjacence = sa.getAdjacence();
+    const auto& parents = sa.getParents();
+    size_t n = sa.getNbArguments();
+    ClassificationGraphe classification;
+
+    bool autoAttaque = false;
+    for (size_t u = 0; u < n && !autoAttaque; ++u) {
+        for (int v : adjacence[u]) if (v == static_cast<int>(u)) { autoAttaque = true; break; }
+    }
+
+    // Acyclique : chaque composante fortement connexe est réduite à un argument sans auto-attaque
+    int nbComposantes = 0;
+    vector<int> composante = composantesFortes(adjacence, nbComposantes);
+    classification.acyclique = !autoAttaque && static_cast<size_t>(nbComposantes) == n;
+
+    // Symétrique : pour chaque argument, les cibles et les attaquants forment le même ensemble
+    classification.symetrique = !autoAttaque;
+    for (size_t u = 0; u < n && classification.symetrique; ++u) {
+        if (adjacence[u].size() != parents[u].size()) { classification.symetrique = false; break; }
+        vector<int> cibles = adjacence[u], attaquants = parents[u];
+        std::sort(cibles.begin(), cibles.end());
+        std::sort(attaquants.begin(), attaquants.end());
+        classification.symetrique = cibles == attaquants;
+    }
+
+    // Biparti : 2-coloration du graphe non orienté complet (une auto-attaque est un cycle impair)
+    vector<int> couleur;
+    classification.biparti = !autoAttaque && deuxColorier(sa, couleur, [](int, int) { return true; });
+    if (classification.biparti) classification.cote = couleur;
+
+    // Sans cycle impair : une composante fortement connexe contient un cycle orienté impair si et seulement si son
+    // graphe non orienté n'est pas biparti, on colorie donc chaque composante avec ses seuls arcs internes
+    classification.sansCycleImpair = classification.acyclique || classification.biparti ||
+        (!autoAttaque && deuxColorier(sa, couleur, [&](int u, int v) { return composante[u] == composante[v]; }));
+    return classification;
+}
+
+EnsembleIds extensionNaive(const SystemeArgumentation& sa, int depart) {
+    const auto& adjacence = sa.getAdjacence();
+    size_t n = sa.getNbArguments();
+    vector<bool> bloque(n, false);  // Dans l'ensemble ou voisin d'un de ses membres
+    EnsembleIds S;
+    auto ajouter = [&](int x) {
+        S.push_back(x);
+        bloque[x] = true;
+        for (int v : adjacence[x]) bloque[v] = true;  // Les attaques étant symétriques, les cibles sont les voisins
+    };
+    if (depart >= 0) ajouter(depart);
+    for (size_t x = 0; x < n; ++x) {
+        if (!bloque[x]) ajouter(static_cast<int>(x));
+    }
+    std::sort(S.begin(), S.end());
+    return S;
+}
+
+vector<bool> argumentsAcceptablesBiparti(const SystemeArgumentation& sa, const vector<int>& cote) {
+    vector<bool> actif(sa.getNbArguments(), true);
+    vector<bool> acceptables = plusGrandAdmissibleCote(sa, cote, 0, actif);
+    vector<bool> cote1 = plusGrandAdmissibleCote(sa, cote, 1, actif);
+    for (size_t i = 0; i < acceptables.size(); ++i) acceptables[i] = acceptables[i] || cote1[i];
+    return acceptables;
+}
+
+EnsembleIds extensionBipartie(const SystemeArgumentation& sa, const vector<int>& cote, int depart) {
+    const auto& adjacence = sa.getAdjacence();
+    size_t n = sa.getNbArguments();
+    vector<bool> actif(n, true);  // Arguments du réduit courant (ni dans E, ni attaqués par E)
+    vector<bool> dansE(n, false);
+
+    // À chaque tour, T admissible dans le réduit de E : E U T est admissible dans le système complet
+    // Quand le réduit n'a plus d'ensemble admissible non vide, E est une extension préférée
+    bool premierTour = true;
+    while (true) {
+        vector<bool> S0 = plusGrandAdmissibleCote(sa, cote, 0, actif);
+        vector<bool> S1 = plusGrandAdmissibleCote(sa, cote, 1, actif);
+        vector<bool> T(n, false);
+        if (premierTour && depart >= 0) {
+            T = cote[depart] == 0 ? S0 : S1;  // Contient depart, qui est acceptable
+        } else {
+            // S0 plus les membres de S1 qu'il n'attaque pas : sans conflit, car S0 contre-attaque tout attaquant
+            T = S0;
+            vector<bool> attaqueParS0(n, false);
+            for (size_t i = 0; i < n; ++i) if (S0[i]) for (int c : adjacence[i]) attaqueParS0[c] = true;
+            for (size_t i = 0; i < n; ++i) if (S1[i] && !attaqueParS0[i]) T[i] = true;
+        }
+        premierTour = false;
+
+        bool vide = true;
+        for (size_t i = 0; i < n; ++i) {
+            if (!T[i]) continue;
+            vide = false;
+            dansE[i] = true;
+            actif[i] = false;
+            for (int c : adjacence[i]) actif[c] = false;
+        }
+        if (vide) break;
+    }
+
+    EnsembleIds E;
+    for (size_t i = 0; i < n; ++i) if (dansE[i]) E.push_back(static_cast<int>(i));
+    return E;
+}
+
+}
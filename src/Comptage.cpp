@@ -0,0 +1,360 @@
+/* Comptage.cpp
+ * Implémentation du comptage d'extensions : recherche avec propagation et cache par composante pour la sémantique
+ * stable, énumération des extensions complètes maximales pour les composantes préférées qui l'exigent. */
+
+#include "Comptage.hpp"
+#include "ClassesGraphe.hpp"
+#include "Budget.hpp"
+#include <algorithm>  // std::sort
+#include <functional>  // std::hash
+#include <queue>  // std::queue
+#include <unordered_map>  // std::unordered_map
+#include <utility>  // std::move, std::pair
+#include <vector>  // std::vector
+
+
+namespace {
+    using std::vector;
+
+    // État d'un argument dans un sous-problème stable
+    enum Etat : char {
+        LIBRE,  // Peut encore entrer dans l'extension
+        EXCLU,  // Hors de l'extension, doit encore être attaqué par un argument qui y entrera
+        RETIRE  // Dans l'extension ou attaqué par elle : plus aucune contrainte
+    };
+
+    // Arguments non décidés (identifiants triés) et leur état, LIBRE ou EXCLU
+    struct SousProbleme {
+        vector<int> arguments;
+        vector<char> etats;
+    };
+
+    // Hachage d'une clé de cache (arguments libres, et exclus codés par -1 - id)
+    struct HacheCle {
+        size_t operator()(const vector<int>& cle) const {
+            size_t h = cle.size();
+            for (int v : cle) h ^= std::hash<int>()(v) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    // Compteur d'extensions stables, le cache vit le temps d'un comptage
+    class CompteurStable {
+    public:
+        explicit CompteurStable(const SystemeArgumentation& sa)
+            : adjacence_(sa.getAdjacence()), parents_(sa.getParents()),
+              autoAttaque_(sa.getNbArguments(), false), position_(sa.getNbArguments(), -1) {
+            for (size_t a = 0; a < adjacence_.size(); ++a) {
+                for (int c : adjacence_[a]) if (c == static_cast<int>(a)) autoAttaque_[a] = true;
+            }
+        }
+
+        // Compte les extensions stables du sous-problème, en y acceptant d'abord l'argument force s'il vaut >= 0
+        GrandEntier compter(const SousProbleme& sp, int force = -1);
+
+    private:
+        // Compte une composante connexe déjà propagée, en passant par le cache, par branchement IN / exclu
+        GrandEntier compterComposante(const SousProbleme& composante);
+
+        const vector<vector<int>>& adjacence_;
+        const vector<vector<int>>& parents_;
+        vector<bool> autoAttaque_;
+        vector<int> position_;  // Position de chaque argument dans le sous-problème en cours d'analyse, -1 sinon
+        std::unordered_map<vector<int>, GrandEntier, HacheCle> cache_;
+    };
+
+    GrandEntier CompteurStable::compter(const SousProbleme& sp, int force) {
+        Budget::verifier();  // Point de contrôle du temps et de la mémoire
+        size_t k = sp.arguments.size();
+        vector<char> etats = sp.etats;
+        for (size_t i = 0; i < k; ++i) position_[sp.arguments[i]] = static_cast<int>(i);
+        // position_ est partagée avec les appels récursifs : elle doit être remise à -1 avant chacun d'eux
+        auto liberer = [&] { for (int a : sp.arguments) position_[a] = -1; };
+
+        // Accepte l'argument local i : ses cibles sont retirées, ses attaquants libres deviennent exclus
+        auto accepter = [&](size_t i) {
+            etats[i] = RETIRE;
+            for (int c : adjacence_[sp.arguments[i]]) {
+                if (position_[c] != -1) etats[position_[c]] = RETIRE;
+            }
+            for (int p : parents_[sp.arguments[i]]) {
+                int j = position_[p];
+                if (j != -1 && etats[j] == LIBRE) etats[j] = EXCLU;
+            }
+        };
+
+        // Un auto-attaquant n'entre jamais dans une extension stable
+        for (size_t i = 0; i < k; ++i) {
+            if (etats[i] == LIBRE && autoAttaque_[sp.arguments[i]]) etats[i] = EXCLU;
+        }
+        if (force >= 0) {
+            int j = position_[force];
+            if (j == -1 || etats[j] != LIBRE) { liberer(); return 0; }
+            accepter(static_cast<size_t>(j));
+        }
+
+        // Propagation jusqu'au point fixe : un libre sans attaquant libre doit entrer (sinon rien ne l'attaquerait),
+        // un exclu sans attaquant libre est une impasse, un exclu avec un seul attaquant libre force celui-ci
+        bool change = true;
+        while (change) {
+            change = false;
+            for (size_t i = 0; i < k; ++i) {
+                if (etats[i] == RETIRE) continue;
+                int nbLibres = 0, dernierLibre = -1;
+                for (int p : parents_[sp.arguments[i]]) {
+                    int j = position_[p];
+                    if (j != -1 && etats[j] == LIBRE) { ++nbLibres; dernierLibre = j; }
+                }
+                if (etats[i] == LIBRE && nbLibres == 0) {
+                    accepter(i);
+                    change = true;
+                } else if (etats[i] == EXCLU && nbLibres == 0) {
+                    liberer();
+                    return 0;
+                } else if (etats[i] == EXCLU && nbLibres == 1) {
+                    accepter(static_cast<size_t>(dernierLibre));
+                    change = true;
+                }
+            }
+        }
+
+        // Composantes connexes des arguments restants : seuls les arcs issus d'un libre comptent, un exclu
+        // n'entrant jamais dans l'extension, ses propres attaques ne contraignent rien
+        vector<SousProbleme> composantes;
+        vector<bool> vu(k, false);
+        for (size_t depart = 0; depart < k; ++depart) {
+            if (etats[depart] == RETIRE || vu[depart]) continue;
+            vector<std::pair<int, char>> membres;
+            std::queue<size_t> file;
+            file.push(depart);
+            vu[depart] = true;
+            while (!file.empty()) {
+                size_t u = file.front();
+                file.pop();
+                membres.emplace_back(sp.arguments[u], etats[u]);
+                auto visiter = [&](int voisin) {
+                    int j = position_[voisin];
+                    if (j == -1 || etats[j] == RETIRE || vu[j]) return;
+                    vu[j] = true;
+                    file.push(static_cast<size_t>(j));
+                };
+                if (etats[u] == LIBRE) for (int c : adjacence_[sp.arguments[u]]) visiter(c);
+                for (int p : parents_[sp.arguments[u]]) {
+                    if (position_[p] != -1 && etats[position_[p]] == LIBRE) visiter(p);
+                }
+            }
+            std::sort(membres.begin(), membres.end());
+            SousProbleme composante;
+            for (const auto& [argument, etat] : membres) {
+                composante.arguments.push_back(argument);
+                composante.etats.push_back(etat);
+            }
+            composantes.push_back(std::move(composante));
+        }
+        liberer();
+
+        // Les composantes sont indépendantes : le nombre d'extensions est le produit de leurs comptes
+        GrandEntier total = 1;
+        for (const SousProbleme& composante : composantes) {
+            GrandEntier compte = compterComposante(composante);
+            if (compte.estNul()) return 0;
+            total *= compte;
+        }
+        return total;
+    }
+
+    GrandEntier CompteurStable::compterComposante(const SousProbleme& composante) {
+        size_t k = composante.arguments.size();
+        vector<int> cle(k);
+        for (size_t i = 0; i < k; ++i) {
+            int a = composante.arguments[i];
+            cle[i] = composante.etats[i] == EXCLU ? -1 - a : a;
+        }
+        auto trouve = cache_.find(cle);
+        if (trouve != cache_.end()) return trouve->second;
+
+        // Branchement sur l'argument libre le plus connecté dans la composante (il y en a toujours un : chaque exclu
+        // restant a au moins deux attaquants libres)
+        for (size_t i = 0; i < k; ++i) position_[composante.arguments[i]] = static_cast<int>(i);
+        size_t meilleur = 0;
+        int meilleurDegre = -1;
+        for (size_t i = 0; i < k; ++i) {
+            if (composante.etats[i] != LIBRE) continue;
+            int degre = 0;
+            for (int c : adjacence_[composante.arguments[i]]) if (position_[c] != -1) ++degre;
+            for (int p : parents_[composante.arguments[i]]) if (position_[p] != -1) ++degre;
+            if (degre > meilleurDegre) { meilleur = i; meilleurDegre = degre; }
+        }
+        for (int a : composante.arguments) position_[a] = -1;
+
+        GrandEntier resultat = compter(composante, composante.arguments[meilleur]);
+        SousProbleme sansArgument = composante;
+        sansArgument.etats[meilleur] = EXCLU;
+        resultat += compter(sansArgument);
+        cache_.emplace(std::move(cle), resultat);
+        return resultat;
+    }
+
+    // Énumère les extensions complètes d'un système par branchement IN / hors dans l'ordre d'un parcours en largeur,
+    // en élaguant dès qu'un attaquant d'un argument IN ne peut plus être contre-attaqué
+    class EnumerateurComplet {
+    public:
+        explicit EnumerateurComplet(const SystemeArgumentation& sa)
+            : adjacence_(sa.getAdjacence()), parents_(sa.getParents()), decision_(sa.getNbArguments(), INCONNU),
+              attaquesParS_(sa.getNbArguments(), 0), autoAttaque_(sa.getNbArguments(), false) {
+            size_t n = sa.getNbArguments();
+            for (size_t a = 0; a < n; ++a) {
+                for (int c : adjacence_[a]) if (c == static_cast<int>(a)) autoAttaque_[a] = true;
+            }
+            vector<bool> vu(n, false);
+            for (size_t depart = 0; depart < n; ++depart) {
+                if (vu[depart]) continue;
+                vu[depart] = true;
+                size_t tete = ordre_.size();
+                ordre_.push_back(static_cast<int>(depart));
+                for (; tete < ordre_.size(); ++tete) {
+                    int u = ordre_[tete];
+                    for (const auto* voisins : {&adjacence_[u], &parents_[u]}) {
+                        for (int v : *voisins) if (!vu[v]) { vu[v] = true; ordre_.push_back(v); }
+                    }
+                }
+            }
+        }
+
+        // Retourne les extensions complètes (arguments IN de chacune, triés)
+        vector<vector<int>> enumerer() {
+            explorer(0);
+            return std::move(completes_);
+        }
+
+    private:
+        enum Decision : char { INCONNU, DEDANS, DEHORS };
+
+        // Vrai si y est attaqué par S ou peut encore l'être par un argument non décidé
+        bool peutEtreContre(int y) const {
+            if (attaquesParS_[y] > 0) return true;
+            for (int p : parents_[y]) if (decision_[p] == INCONNU) return true;
+            return false;
+        }
+
+        void explorer(size_t pos) {
+            Budget::verifier();  // Point de contrôle du temps et de la mémoire
+            size_t n = decision_.size();
+            if (pos == n) {
+                // S doit être admissible, et complet : tout argument défendu par S lui appartient
+                for (size_t x = 0; x < n; ++x) {
+                    bool defendu = true;
+                    for (int y : parents_[x]) if (attaquesParS_[y] == 0) { defendu = false; break; }
+                    if ((decision_[x] == DEDANS) != defendu) return;
+                }
+                vector<int> S;
+                for (size_t x = 0; x < n; ++x) if (decision_[x] == DEDANS) S.push_back(static_cast<int>(x));
+                completes_.push_back(std::move(S));
+                return;
+            }
+
+            int x = ordre_[pos];
+            // Branche 1 - x entre dans S s'il n'est en conflit avec aucun de ses membres
+            bool possible = !autoAttaque_[x] && attaquesParS_[x] == 0;
+            for (int c : adjacence_[x]) if (decision_[c] == DEDANS) { possible = false; break; }
+            if (possible) {
+                decision_[x] = DEDANS;
+                for (int c : adjacence_[x]) ++attaquesParS_[c];
+                bool viable = true;
+                for (int y : parents_[x]) if (!peutEtreContre(y)) { viable = false; break; }
+                if (viable) explorer(pos + 1);
+                for (int c : adjacence_[x]) --attaquesParS_[c];
+            }
+            // Branche 2 - x reste hors de S : les cibles de x qui attaquent S doivent garder un contre-attaquant
+            decision_[x] = DEHORS;
+            bool viable = true;
+            for (int y : adjacence_[x]) {
+                if (peutEtreContre(y)) continue;
+                for (int c : adjacence_[y]) if (decision_[c] == DEDANS) { viable = false; break; }
+                if (!viable) break;
+            }
+            if (viable) explorer(pos + 1);
+            decision_[x] = INCONNU;
+        }
+
+        const vector<vector<int>>& adjacence_;
+        const vector<vector<int>>& parents_;
+        vector<char> decision_;
+        vector<int> attaquesParS_;  // Nombre de membres de S qui attaquent chaque argument
+        vector<bool> autoAttaque_;
+        vector<int> ordre_;
+        vector<vector<int>> completes_;
+    };
+
+    // Nombre d'extensions préférées (complètes maximales pour l'inclusion) contenant argId, ou toutes si argId < 0
+    GrandEntier compterPrefereesParEnumeration(const SystemeArgumentation& sa, int argId) {
+        vector<vector<int>> completes = EnumerateurComplet(sa).enumerer();
+        std::sort(completes.begin(), completes.end(),
+                  [](const vector<int>& a, const vector<int>& b) { return a.size() > b.size(); });
+        vector<vector<bool>> maximales;
+        uint64_t compte = 0;
+        for (const vector<int>& S : completes) {
+            bool incluse = false;
+            for (const vector<bool>& M : maximales) {
+                incluse = true;
+                for (int x : S) if (!M[x]) { incluse = false; break; }
+                if (incluse) break;
+            }
+            if (incluse) continue;
+            vector<bool> appartient(sa.getNbArguments(), false);
+            for (int x : S) appartient[x] = true;
+            if (argId < 0 || appartient[argId]) ++compte;
+            maximales.push_back(std::move(appartient));
+        }
+        return compte;
+    }
+}
+
+
+namespace Comptage {
+
+GrandEntier compterStables(const SystemeArgumentation& sa, int argId) {
+    SousProbleme tout;
+    for (size_t i = 0; i < sa.getNbArguments(); ++i) tout.arguments.push_back(static_cast<int>(i));
+    tout.etats.assign(tout.arguments.size(), LIBRE);
+    return CompteurStable(sa).compter(tout, argId);
+}
+
+GrandEntier compterPreferees(const SystemeArgumentation& sa, int argId) {
+    const auto& adjacence = sa.getAdjacence();
+    const auto& parents = sa.getParents();
+    size_t n = sa.getNbArguments();
+    vector<int> local(n, -1);  // Identifiant dans le sous-système de sa composante
+    vector<bool> vu(n, false);
+    GrandEntier total = 1;
+
+    for (size_t depart = 0; depart < n; ++depart) {
+        if (vu[depart]) continue;
+        // Composante connexe (arcs non orientés), dans l'ordre des identifiants d'origine
+        vector<int> membres{static_cast<int>(depart)};
+        vu[depart] = true;
+        for (size_t tete = 0; tete < membres.size(); ++tete) {
+            int u = membres[tete];
+            for (const auto* voisins : {&adjacence[u], &parents[u]}) {
+                for (int v : *voisins) if (!vu[v]) { vu[v] = true; membres.push_back(v); }
+            }
+        }
+        std::sort(membres.begin(), membres.end());
+
+        ConstructeurSysteme constructeur;
+        for (int a : membres) local[a] = constructeur.ajouterArgument(sa.getNom(a));
+        for (int a : membres) for (int c : adjacence[a]) constructeur.ajouterAttaque(local[a], local[c]);
+        SystemeArgumentation sous = constructeur.finaliser();
+        int argLocal = argId >= 0 ? local[argId] : -1;  // -1 si argId est dans une autre composante
+
+        GrandEntier compte = ClassesGraphe::classifier(sous).estCoherent()
+            ? compterStables(sous, argLocal)
+            : compterPrefereesParEnumeration(sous, argLocal);
+        for (int a : membres) local[a] = -1;
+        if (compte.estNul()) return 0;
+        total *= compte;
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,110 @@
+/* CompteurMemoire.cpp
+ * Compteurs atomiques par phase et rapport JSON de l'empreinte mémoire. */
+
+#include "CompteurMemoire.hpp"
+#include "Budget.hpp"
+
+
+namespace {
+    using CompteurMemoire::NB_PHASES;
+
+    std::atomic<uint64_t> allocations[NB_PHASES];
+    std::atomic<uint64_t> octetsAlloues[NB_PHASES];
+    std::atomic<int64_t> picPhase[NB_PHASES];
+    std::atomic<int64_t> octetsVivants{0};
+    std::atomic<int64_t> picGlobal{0};
+
+    // Relève maximum à valeur si elle le dépasse
+    void releverMaximum(std::atomic<int64_t>& maximum, int64_t valeur) {
+        int64_t courant = maximum.load(std::memory_order_relaxed);
+        while (valeur > courant && !maximum.compare_exchange_weak(courant, valeur, std::memory_order_relaxed)) {}
+    }
+
+    // Objet JSON des octets de chaque structure d'un système
+    void ecrireSysteme(std::ostream& sortie, const SystemeArgumentation& sa) {
+        EmpreinteMemoire empreinte = sa.empreinteMemoire();
+        size_t nbAttaques = 0;
+        for (const auto& cibles : sa.getAdjacence()) nbAttaques += cibles.size();
+        sortie << "{\"arguments\": " << sa.getNbArguments() << ", \"attaques\": " << nbAttaques
+               << ", \"octets\": {\"arene\": " << empreinte.arene << ", \"debuts\": " << empreinte.debuts
+               << ", \"table\": " << empreinte.table << ", \"adjacence\": " << empreinte.adjacence
+               << ", \"parents\": " << empreinte.parents << ", \"rangs\": " << empreinte.rangs
+               << ", \"total\": " << empreinte.total() << "}}";
+    }
+}
+
+
+namespace CompteurMemoire {
+
+void activer() {
+    detail::actif.store(true, std::memory_order_relaxed);
+}
+
+Bilan bilan() {
+    Bilan resultat;
+    resultat.actif = detail::actif.load(std::memory_order_relaxed);
+    for (size_t p = 0; p < NB_PHASES; ++p) {
+        resultat.phases[p].allocations = allocations[p].load(std::memory_order_relaxed);
+        resultat.phases[p].octetsAlloues = octetsAlloues[p].load(std::memory_order_relaxed);
+        resultat.phases[p].picOctets = picPhase[p].load(std::memory_order_relaxed);
+    }
+    resultat.octetsVivants = octetsVivants.load(std::memory_order_relaxed);
+    resultat.picOctets = picGlobal.load(std::memory_order_relaxed);
+    // Aucune allocation vue : les opérateurs remplacés ne sont pas liés (bibliothèque partagée)
+    uint64_t total = 0;
+    for (const BilanPhase& phase : resultat.phases) total += phase.allocations;
+    resultat.actif = resultat.actif && total > 0;
+    return resultat;
+}
+
+const char* nomPhase(Phase phase) {
+    switch (phase) {
+        case Phase::CHARGEMENT: return "chargement";
+        case Phase::PRETRAITEMENT: return "pretraitement";
+        case Phase::RECHERCHE: return "recherche";
+        default: return "autre";
+    }
+}
+
+void ecrireRapport(std::ostream& sortie, const Bilan& compteurs, const SystemeArgumentation* original,
+                   const SystemeArgumentation* reduit) {
+    sortie << "{\n  \"compteur_actif\": " << (compteurs.actif ? "true" : "false");
+    if (original) {
+        sortie << ",\n  \"systeme\": ";
+        ecrireSysteme(sortie, *original);
+    }
+    if (reduit) {
+        sortie << ",\n  \"systeme_reduit\": ";
+        ecrireSysteme(sortie, *reduit);
+    }
+    sortie << ",\n  \"phases\": {";
+    for (size_t p = 0; p < NB_PHASES; ++p) {
+        const BilanPhase& phase = compteurs.phases[p];
+        sortie << (p > 0 ? ", " : "") << "\"" << nomPhase(static_cast<Phase>(p)) << "\": {\"allocations\": "
+               << phase.allocations << ", \"octets_alloues\": " << phase.octetsAlloues
+               << ", \"pic_octets\": " << phase.picOctets << "}";
+    }
+    sortie << "},\n  \"tas\": {\"vivant_octets\": " << compteurs.octetsVivants << ", \"pic_octets\": "
+           << compteurs.picOctets << "},\n  \"pic_residentiel_mo\": " << Budget::statistiques().memoireMo << "\n}"
+           << std::endl;
+}
+
+namespace detail {
+
+void enregistrerAllocation(size_t octets) {
+    size_t p = static_cast<size_t>(phaseCourante);
+    allocations[p].fetch_add(1, std::memory_order_relaxed);
+    octetsAlloues[p].fetch_add(octets, std::memory_order_relaxed);
+    int64_t vivants = octetsVivants.fetch_add(static_cast<int64_t>(octets), std::memory_order_relaxed)
+                      + static_cast<int64_t>(octets);
+    releverMaximum(picPhase[p], vivants);
+    releverMaximum(picGlobal, vivants);
+}
+
+void enregistrerLiberation(size_t octets) {
+    octetsVivants.fetch_sub(static_cast<int64_t>(octets), std::memory_order_relaxed);
+}
+
+}
+
+}
@@ -0,0 +1,286 @@
+/* DecompositionArborescente.cpp
+ * Élimination par degré minimal, puis programmation dynamique ascendante sur les sacs avec reconstruction du témoin. */
+
+#include "DecompositionArborescente.hpp"
+#include "Budget.hpp"
+#include <algorithm>  // std::max, std::min_element, std::sort, std::unique
+#include <cstdint>  // uint64_t
+#include <functional>  // std::greater
+#include <queue>  // std::priority_queue
+#include <set>  // std::set
+#include <unordered_map>  // std::unordered_map
+#include <utility>  // std::pair, std::move
+
+
+namespace {
+    using std::vector;
+    using Candidat = std::pair<size_t, int>;  // (degré, argument)
+    using FileDegres = std::priority_queue<Candidat, vector<Candidat>, std::greater<Candidat>>;
+
+    // Chaque argument d'un sac occupe BITS bits de l'état : dans l'ensemble, attaqué par l'ensemble, attaquant de
+    // l'ensemble. La position 0 est l'argument éliminé par le sac, la position k + 1 le k-ième de son séparateur,
+    // si bien que l'état du séparateur s'obtient par un simple décalage
+    constexpr int BITS = 3;
+    constexpr uint64_t IN = 1, ATTAQUE = 2, ATTAQUANT = 4, MASQUE = 7;
+
+    inline uint64_t lire(uint64_t etat, size_t position) {
+        return (etat >> (BITS * position)) & MASQUE;
+    }
+
+    // Choix retenu pour un état du séparateur : l'argument éliminé est-il dedans, et quels états des enfants y mènent
+    struct Entree {
+        bool dedans;
+        vector<uint64_t> etatsEnfants;  // Dans l'ordre de enfants_, rempli seulement si un témoin est demandé
+    };
+    using Table = std::unordered_map<uint64_t, Entree>;
+
+    // Graphe d'attaque non orienté, sans boucles ni doublons
+    vector<vector<int>> grapheNonOriente(const SystemeArgumentation& sa) {
+        const auto& adjacence = sa.getAdjacence();
+        size_t n = sa.getNbArguments();
+        vector<vector<int>> voisins(n);
+        for (size_t i = 0; i < n; ++i) {
+            for (int j : adjacence[i]) {
+                if (j == static_cast<int>(i)) continue;
+                voisins[i].push_back(j);
+                voisins[j].push_back(static_cast<int>(i));
+            }
+        }
+        for (auto& liste : voisins) {
+            std::sort(liste.begin(), liste.end());
+            liste.erase(std::unique(liste.begin(), liste.end()), liste.end());
+        }
+        return voisins;
+    }
+
+    // Dégénérescence du graphe (plus grand degré minimal rencontré en retirant les sommets un à un), minorant de la
+    // largeur arborescente : elle écarte les graphes denses sans construire les cliques de l'élimination
+    size_t degenerescence(const vector<vector<int>>& voisins) {
+        size_t n = voisins.size();
+        vector<size_t> degre(n);
+        FileDegres file;
+        for (size_t i = 0; i < n; ++i) {
+            degre[i] = voisins[i].size();
+            file.push({degre[i], static_cast<int>(i)});
+        }
+        vector<bool> retire(n, false);
+        size_t resultat = 0;
+        while (!file.empty()) {
+            auto [d, v] = file.top();
+            file.pop();
+            if (retire[v] || d != degre[v]) continue;  // Entrée périmée
+            retire[v] = true;
+            resultat = std::max(resultat, d);
+            for (int u : voisins[v]) {
+                if (!retire[u]) file.push({--degre[u], u});
+            }
+        }
+        return resultat;
+    }
+}
+
+
+// Ordre d'élimination de degré minimal : les voisins de l'argument éliminé forment son séparateur et deviennent une
+// clique ; le parent d'un sac est celui du premier de ces voisins éliminé ensuite
+DecompositionArborescente::DecompositionArborescente(const SystemeArgumentation& sa, int largeurMax) : sa_(sa) {
+    size_t n = sa.getNbArguments();
+    vector<vector<int>> graphe = grapheNonOriente(sa);
+    largeur_ = static_cast<int>(degenerescence(graphe));
+    if (largeur_ > largeurMax) return;
+
+    vector<std::set<int>> voisins(n);
+    FileDegres file;
+    for (size_t i = 0; i < n; ++i) {
+        voisins[i].insert(graphe[i].begin(), graphe[i].end());
+        file.push({voisins[i].size(), static_cast<int>(i)});
+    }
+    graphe.clear();
+
+    separateurs_.resize(n);
+    enfants_.resize(n);
+    ordre_.reserve(n);
+    vector<int> position(n, -1);  // Rang d'élimination
+    while (!file.empty()) {
+        auto [degre, v] = file.top();
+        file.pop();
+        if (position[v] >= 0 || degre != voisins[v].size()) continue;  // Entrée périmée
+        largeur_ = std::max(largeur_, static_cast<int>(degre));
+        if (largeur_ > largeurMax) return;  // Même le meilleur candidat formerait un sac trop grand
+        position[v] = static_cast<int>(ordre_.size());
+        ordre_.push_back(v);
+        separateurs_[v].assign(voisins[v].begin(), voisins[v].end());
+        for (int u : separateurs_[v]) {
+            voisins[u].erase(v);
+            for (int w : separateurs_[v]) if (w != u) voisins[u].insert(w);
+            file.push({voisins[u].size(), u});
+        }
+        voisins[v].clear();
+    }
+
+    for (int v : ordre_) {
+        const auto& separateur = separateurs_[v];
+        if (separateur.empty()) {
+            racines_.push_back(v);
+            continue;
+        }
+        int parent = *std::min_element(separateur.begin(), separateur.end(),
+                                       [&](int a, int b) { return position[a] < position[b]; });
+        enfants_[parent].push_back(v);
+    }
+    applicable_ = true;
+}
+
+bool DecompositionArborescente::estApplicable() const {
+    return applicable_;
+}
+
+int DecompositionArborescente::getLargeur() const {
+    return largeur_;
+}
+
+// Programmation dynamique dans l'ordre d'élimination (chaque sac après ses enfants). La table d'un sac associe à
+// chaque état de son séparateur une façon de choisir les arguments déjà éliminés de son sous-arbre ; chaque attaque
+// est prise en compte dans le sac du premier éliminé de ses deux extrémités, où les deux figurent, et un argument
+// éliminé n'en recevra plus aucune, d'où le contrôle de sa condition à ce moment
+bool DecompositionArborescente::resoudre(Mode mode, int argForce, bool dedans,
+                                         std::optional<Utilitaires::EnsembleIds>* temoin) const {
+    const auto& adjacence = sa_.getAdjacence();
+    const auto& parents = sa_.getParents();
+    size_t n = sa_.getNbArguments();
+    vector<Table> tables(n);
+    vector<int> positionDansSac(n, -1);  // Position des arguments du sac courant, -1 pour les autres
+    vector<std::pair<size_t, size_t>> arcs;  // Attaques du sac courant, en positions (source, cible)
+
+    for (int v : ordre_) {
+        Budget::verifier();  // Point de contrôle du temps et de la mémoire
+        const auto& separateur = separateurs_[v];
+        size_t taille = separateur.size() + 1;
+        positionDansSac[v] = 0;
+        for (size_t k = 0; k < separateur.size(); ++k) positionDansSac[separateur[k]] = static_cast<int>(k + 1);
+
+        // Tous les choix dedans / dehors des arguments du sac, l'argument forcé n'en ayant qu'un
+        std::unordered_map<uint64_t, vector<uint64_t>> courant;  // État du sac -> états des enfants déjà joints
+        for (uint64_t choix = 0; choix < (uint64_t(1) << taille); ++choix) {
+            uint64_t etat = 0;
+            bool valide = true;
+            for (size_t k = 0; k < taille && valide; ++k) {
+                bool estDedans = (choix >> k) & 1;
+                int arg = k == 0 ? v : separateur[k - 1];
+                if (arg == argForce && estDedans != dedans) valide = false;
+                if (estDedans) etat |= IN << (BITS * k);
+            }
+            if (valide) courant.emplace(etat, vector<uint64_t>{});
+        }
+
+        // Jointure avec chaque enfant : les bits IN doivent coïncider sur son séparateur (inclus dans le sac), les
+        // drapeaux s'unissent car ils proviennent d'attaques disjointes
+        for (int enfant : enfants_[v]) {
+            const auto& separateurEnfant = separateurs_[enfant];
+            vector<size_t> correspondance(separateurEnfant.size());
+            uint64_t masqueIn = 0;
+            for (size_t j = 0; j < separateurEnfant.size(); ++j) {
+                correspondance[j] = static_cast<size_t>(positionDansSac[separateurEnfant[j]]);
+                masqueIn |= IN << (BITS * correspondance[j]);
+            }
+            // États de l'enfant traduits en positions du sac, regroupés par bits IN
+            std::unordered_map<uint64_t, vector<std::pair<uint64_t, uint64_t>>> parIn;
+            for (const auto& [etatEnfant, entree] : tables[enfant]) {
+                uint64_t traduit = 0;
+                for (size_t j = 0; j < correspondance.size(); ++j) {
+                    traduit |= lire(etatEnfant, j) << (BITS * correspondance[j]);
+                }
+                parIn[traduit & masqueIn].push_back({traduit, etatEnfant});
+            }
+            std::unordered_map<uint64_t, vector<uint64_t>> suivant;
+            for (auto& [etat, etatsEnfants] : courant) {
+                auto compatibles = parIn.find(etat & masqueIn);
+                if (compatibles == parIn.end()) continue;
+                for (const auto& [traduit, etatEnfant] : compatibles->second) {
+                    auto [place, nouveau] = suivant.try_emplace(etat | traduit);
+                    if (!nouveau || !temoin) continue;
+                    place->second = etatsEnfants;
+                    place->second.push_back(etatEnfant);
+                }
+            }
+            courant = std::move(suivant);
+            if (!temoin) Table().swap(tables[enfant]);  // La table de l'enfant ne sert plus qu'à la reconstruction
+            if (courant.empty()) return false;
+        }
+
+        // Attaques entre l'argument éliminé et son séparateur, boucle comprise
+        arcs.clear();
+        for (int cible : adjacence[v]) {
+            if (positionDansSac[cible] >= 0) arcs.push_back({0, static_cast<size_t>(positionDansSac[cible])});
+        }
+        for (int source : parents[v]) {
+            if (positionDansSac[source] > 0) arcs.push_back({static_cast<size_t>(positionDansSac[source]), 0});
+        }
+
+        Table& table = tables[v];
+        for (auto& [etatInitial, etatsEnfants] : courant) {
+            uint64_t etat = etatInitial;
+            bool valide = true;
+            for (auto [source, cible] : arcs) {
+                bool sourceIn = lire(etat, source) & IN, cibleIn = lire(etat, cible) & IN;
+                if (sourceIn && cibleIn) {  // Conflit
+                    valide = false;
+                    break;
+                }
+                if (sourceIn) etat |= ATTAQUE << (BITS * cible);
+                if (cibleIn && mode == Mode::ADMISSIBLE) etat |= ATTAQUANT << (BITS * source);
+            }
+            if (!valide) continue;
+            // Hors de l'ensemble, l'argument éliminé doit être attaqué par lui (stable), ou seulement s'il l'attaque
+            // lui-même (admissible : l'ensemble se défend)
+            uint64_t propre = lire(etat, 0);
+            if (!(propre & IN) && (mode == Mode::STABLE || (propre & ATTAQUANT)) && !(propre & ATTAQUE)) continue;
+            auto [place, nouveau] = table.try_emplace(etat >> BITS);
+            if (nouveau) place->second = Entree{(propre & IN) != 0, std::move(etatsEnfants)};
+        }
+
+        positionDansSac[v] = -1;
+        for (int u : separateur) positionDansSac[u] = -1;
+        if (table.empty()) return false;
+    }
+
+    // Chaque racine a une table non vide réduite à l'état vide : on redescend les choix retenus
+    if (temoin) {
+        Utilitaires::EnsembleIds S;
+        vector<std::pair<int, uint64_t>> pile;
+        for (int racine : racines_) pile.push_back({racine, 0});
+        while (!pile.empty()) {
+            auto [v, etat] = pile.back();
+            pile.pop_back();
+            const Entree& entree = tables[v].at(etat);
+            if (entree.dedans) S.push_back(v);
+            for (size_t i = 0; i < enfants_[v].size(); ++i) pile.push_back({enfants_[v][i], entree.etatsEnfants[i]});
+        }
+        std::sort(S.begin(), S.end());
+        *temoin = S;
+    }
+    return true;
+}
+
+// Acceptabilité crédule stable : une extension stable contenant argId
+bool DecompositionArborescente::credulousStable(int argId, std::optional<Utilitaires::EnsembleIds>* temoin) const {
+    return resoudre(Mode::STABLE, argId, true, temoin);
+}
+
+// Acceptabilité crédule préférée : tout ensemble admissible est inclus dans une extension préférée
+bool DecompositionArborescente::credulousPreferred(int argId, std::optional<Utilitaires::EnsembleIds>* temoin) const {
+    return resoudre(Mode::ADMISSIBLE, argId, true, temoin);
+}
+
+// Acceptabilité sceptique stable : crédule, et aucune extension stable sans argId (le témoin en est une)
+bool DecompositionArborescente::skepticalStable(int argId, std::optional<Utilitaires::EnsembleIds>* temoin) const {
+    if (!resoudre(Mode::STABLE, argId, true, nullptr)) {  // Toute extension stable le réfute, s'il en existe une
+        if (temoin) existeStable(temoin);
+        return false;
+    }
+    return !resoudre(Mode::STABLE, argId, false, temoin);
+}
+
+// Existence d'une extension stable : aucun argument forcé
+bool DecompositionArborescente::existeStable(std::optional<Utilitaires::EnsembleIds>* temoin) const {
+    return resoudre(Mode::STABLE, -1, false, temoin);
+}
@@ -0,0 +1,92 @@
+/* GrandEntier.cpp
+ * Arithmétique en précision arbitraire (addition, multiplication, conversion décimale). */
+
+#include "GrandEntier.hpp"
+#include <algorithm>  // std::reverse, std::max
+#include <utility>  // std::move
+
+
+std::vector<uint32_t> GrandEntier::versChiffres() const {
+    if (!chiffres_.empty()) return chiffres_;
+    std::vector<uint32_t> chiffres;
+    for (uint64_t v = petit_; v != 0; v >>= 32) chiffres.push_back(static_cast<uint32_t>(v));
+    return chiffres;
+}
+
+void GrandEntier::depuisChiffres(std::vector<uint32_t> chiffres) {
+    while (!chiffres.empty() && chiffres.back() == 0) chiffres.pop_back();
+    if (chiffres.size() <= 2) {
+        petit_ = 0;
+        for (size_t i = chiffres.size(); i-- > 0;) petit_ = (petit_ << 32) | chiffres[i];
+        chiffres_.clear();
+    } else {
+        petit_ = 0;
+        chiffres_ = std::move(chiffres);
+    }
+}
+
+GrandEntier& GrandEntier::operator+=(const GrandEntier& autre) {
+    // Cas courant : les deux valeurs tiennent sur 64 bits et la somme aussi
+    uint64_t somme;
+    if (chiffres_.empty() && autre.chiffres_.empty() && !__builtin_add_overflow(petit_, autre.petit_, &somme)) {
+        petit_ = somme;
+        return *this;
+    }
+    std::vector<uint32_t> a = versChiffres(), b = autre.versChiffres();
+    a.resize(std::max(a.size(), b.size()) + 1, 0);
+    uint64_t retenue = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        uint64_t s = retenue + a[i] + (i < b.size() ? b[i] : 0);
+        a[i] = static_cast<uint32_t>(s);
+        retenue = s >> 32;
+    }
+    depuisChiffres(std::move(a));
+    return *this;
+}
+
+GrandEntier& GrandEntier::operator*=(const GrandEntier& autre) {
+    uint64_t produit;
+    if (chiffres_.empty() && autre.chiffres_.empty() && !__builtin_mul_overflow(petit_, autre.petit_, &produit)) {
+        petit_ = produit;
+        return *this;
+    }
+    std::vector<uint32_t> a = versChiffres(), b = autre.versChiffres();
+    std::vector<uint32_t> resultat(a.size() + b.size(), 0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        uint64_t retenue = 0;
+        for (size_t j = 0; j < b.size(); ++j) {
+            uint64_t p = static_cast<uint64_t>(a[i]) * b[j] + resultat[i + j] + retenue;
+            resultat[i + j] = static_cast<uint32_t>(p);
+            retenue = p >> 32;
+        }
+        resultat[i + b.size()] = static_cast<uint32_t>(retenue);
+    }
+    depuisChiffres(std::move(resultat));
+    return *this;
+}
+
+bool GrandEntier::operator==(const GrandEntier& autre) const {
+    return petit_ == autre.petit_ && chiffres_ == autre.chiffres_;
+}
+
+std::string GrandEntier::versChaine() const {
+    if (chiffres_.empty()) return std::to_string(petit_);
+    // Divisions successives par 10^9, chaque reste donnant 9 chiffres décimaux
+    std::vector<uint32_t> chiffres = chiffres_;
+    std::string texte;
+    while (!chiffres.empty()) {
+        uint64_t reste = 0;
+        for (size_t i = chiffres.size(); i-- > 0;) {
+            uint64_t courant = (reste << 32) | chiffres[i];
+            chiffres[i] = static_cast<uint32_t>(courant / 1000000000u);
+            reste = courant % 1000000000u;
+        }
+        while (!chiffres.empty() && chiffres.back() == 0) chiffres.pop_back();
+        for (int k = 0; k < 9 && (reste != 0 || !chiffres.empty()); ++k) {
+            texte += static_cast<char>('0' + reste % 10);
+            reste /= 10;
+        }
+    }
+    std::reverse(texte.begin(), texte.end());
+    return texte;
+}
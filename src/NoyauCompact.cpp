@@ -0,0 +1,408 @@
+/* NoyauCompact.cpp
+ * Implémentation des noyaux compacts : recherche par labelling sur des masques de bits, sans allocation dynamique. */
+
+#include "NoyauCompact.hpp"
+#include "Budget.hpp"
+#include <vector>  // std::vector
+
+
+// Opérations ensemblistes sur les tableaux de mots, encapsulées dans un namespace anonyme
+namespace {
+    template <size_t W>
+    using Ens = std::array<uint64_t, W>;
+
+    template <size_t W>
+    inline bool contient(const Ens<W>& e, size_t i) {
+        return (e[i >> 6] >> (i & 63)) & 1u;
+    }
+    template <size_t W>
+    inline void ajouter(Ens<W>& e, size_t i) {
+        e[i >> 6] |= uint64_t(1) << (i & 63);
+    }
+    template <size_t W>
+    inline void unir(Ens<W>& e, const Ens<W>& f) {
+        for (size_t k = 0; k < W; ++k) e[k] |= f[k];
+    }
+    template <size_t W>
+    inline bool intersecte(const Ens<W>& e, const Ens<W>& f) {
+        for (size_t k = 0; k < W; ++k) if (e[k] & f[k]) return true;
+        return false;
+    }
+    // Vrai si e est inclus dans f
+    template <size_t W>
+    inline bool inclus(const Ens<W>& e, const Ens<W>& f) {
+        for (size_t k = 0; k < W; ++k) if (e[k] & ~f[k]) return false;
+        return true;
+    }
+    template <size_t W>
+    inline bool estVide(const Ens<W>& e) {
+        for (size_t k = 0; k < W; ++k) if (e[k]) return false;
+        return true;
+    }
+    // Calcule e \ f
+    template <size_t W>
+    inline Ens<W> sauf(const Ens<W>& e, const Ens<W>& f) {
+        Ens<W> r;
+        for (size_t k = 0; k < W; ++k) r[k] = e[k] & ~f[k];
+        return r;
+    }
+    template <size_t W>
+    inline Ens<W> inter(const Ens<W>& e, const Ens<W>& f) {
+        Ens<W> r;
+        for (size_t k = 0; k < W; ++k) r[k] = e[k] & f[k];
+        return r;
+    }
+    // Cardinal de l'ensemble (popcount)
+    template <size_t W>
+    inline int cardinal(const Ens<W>& e) {
+        int total = 0;
+        for (size_t k = 0; k < W; ++k) total += __builtin_popcountll(e[k]);
+        return total;
+    }
+    // Parcourt les éléments de l'ensemble dans l'ordre croissant
+    template <size_t W, typename Fonction>
+    inline void pourChaque(const Ens<W>& e, Fonction&& fonction) {
+        for (size_t k = 0; k < W; ++k) {
+            uint64_t mot = e[k];
+            while (mot) {
+                fonction(static_cast<int>(k * 64 + __builtin_ctzll(mot)));
+                mot &= mot - 1;  // Retire le bit de poids faible
+            }
+        }
+    }
+}
+
+
+// Construit les masques de bits à partir des listes d'adjacence
+template <size_t NbMots>
+NoyauCompact<NbMots>::NoyauCompact(const SystemeArgumentation& sa)
+    : n_(sa.getNbArguments()), tous_{}, autoAttaques_{}, cibles_{}, attaquants_{} {
+    const auto& adjacence = sa.getAdjacence();
+    for (size_t u = 0; u < n_; ++u) {
+        ajouter(tous_, u);
+        for (int v : adjacence[u]) {
+            ajouter(cibles_[u], static_cast<size_t>(v));
+            ajouter(attaquants_[v], u);
+            if (static_cast<size_t>(v) == u) ajouter(autoAttaques_, u);
+        }
+    }
+}
+
+// Convertit une liste d'identifiants en ensemble
+template <size_t NbMots>
+typename NoyauCompact<NbMots>::Ensemble NoyauCompact<NbMots>::versEnsemble(const Utilitaires::EnsembleIds& S) const {
+    Ensemble e{};
+    for (int id : S) ajouter(e, static_cast<size_t>(id));
+    return e;
+}
+
+// Convertit un ensemble en liste triée d'identifiants
+template <size_t NbMots>
+Utilitaires::EnsembleIds NoyauCompact<NbMots>::versIds(const Ensemble& e) {
+    Utilitaires::EnsembleIds S;
+    pourChaque(e, [&](int i) { S.push_back(i); });
+    return S;
+}
+
+// Recherche d'extension stable : propagation unitaire puis branchement
+template <size_t NbMots>
+bool NoyauCompact<NbMots>::chercherStable(Ensemble in, Ensemble out, Ensemble couverts, Ensemble& trouve) const {
+    Budget::verifier();  // Point de contrôle du temps et de la mémoire
+    // Un argument IN rend ses cibles couvertes et interdit à ses attaquants d'être IN
+    auto passerIn = [&](int y) {
+        ajouter(in, static_cast<size_t>(y));
+        unir(couverts, cibles_[y]);
+        unir(out, attaquants_[y]);
+    };
+
+    Ensemble indecis{};
+    int meilleurEnAttente = -1;  // Argument OUT non couvert ayant le moins de candidats pour l'attaquer
+    int meilleurNbCandidats = 0;
+    bool change = true;
+    while (change) {  // Propagation jusqu'au point fixe
+        change = false;
+        if (intersecte(in, couverts) || intersecte(in, out)) return false;  // Conflit
+
+        indecis = sauf(sauf(sauf(tous_, in), out), couverts);
+        Ensemble enAttente = sauf(sauf(out, in), couverts);  // OUT qui doivent encore être attaqués par un IN
+        meilleurEnAttente = -1;
+
+        // Un OUT non couvert doit avoir au moins un attaquant encore indécis, s'il n'en reste qu'un il passe IN
+        bool echec = false;
+        pourChaque(enAttente, [&](int x) {
+            if (echec || change) return;
+            Ensemble candidats = inter(attaquants_[x], indecis);
+            int nb = cardinal(candidats);
+            if (nb == 0) { echec = true; return; }
+            if (nb == 1) {
+                pourChaque(candidats, passerIn);
+                change = true;
+                return;
+            }
+            if (meilleurEnAttente == -1 || nb < meilleurNbCandidats) {
+                meilleurEnAttente = x;
+                meilleurNbCandidats = nb;
+            }
+        });
+        if (echec) return false;
+        if (change) continue;
+
+        // Un indécis qu'aucun autre indécis ne peut attaquer doit lui-même être IN
+        pourChaque(indecis, [&](int x) {
+            if (change) return;
+            Ensemble attaquantsPossibles = inter(attaquants_[x], indecis);
+            if (estVide(attaquantsPossibles)) {
+                passerIn(x);
+                change = true;
+            }
+        });
+    }
+
+    // Branchement sur les attaquants possibles de l'argument en attente le plus contraint
+    if (meilleurEnAttente != -1) {
+        Ensemble candidats = inter(attaquants_[meilleurEnAttente], indecis);
+        bool succes = false;
+        pourChaque(candidats, [&](int y) {
+            if (succes) return;
+            Ensemble in2 = in, out2 = out, couverts2 = couverts;
+            ajouter(in2, static_cast<size_t>(y));
+            unir(couverts2, cibles_[y]);
+            unir(out2, attaquants_[y]);
+            if (chercherStable(in2, out2, couverts2, trouve)) { succes = true; return; }
+            ajouter(out, static_cast<size_t>(y));  // Les branches suivantes excluent y
+        });
+        return succes;
+    }
+
+    // Sinon, branchement IN / OUT sur le premier argument indécis
+    int x = -1;
+    pourChaque(indecis, [&](int i) { if (x == -1) x = i; });
+    if (x == -1) {  // Tout est décidé et chaque OUT est couvert
+        trouve = in;
+        return true;
+    }
+
+    {
+        Ensemble in2 = in, out2 = out, couverts2 = couverts;
+        ajouter(in2, static_cast<size_t>(x));
+        unir(couverts2, cibles_[x]);
+        unir(out2, attaquants_[x]);
+        if (chercherStable(in2, out2, couverts2, trouve)) return true;
+    }
+    ajouter(out, static_cast<size_t>(x));
+    return chercherStable(in, out, couverts, trouve);
+}
+
+// Recherche d'ensemble admissible : on choisit l'attaquant non contré le plus contraint et on branche sur ses
+// contre-attaquants possibles, puis sur les ensembles à quitter
+template <size_t NbMots>
+bool NoyauCompact<NbMots>::chercherAdmissible(Ensemble in, Ensemble exclus, Ensemble& trouve,
+                                              const Ensemble* aQuitter, size_t nbAQuitter) const {
+    Budget::verifier();
+    Ensemble couverts{}, menaceurs{};
+    pourChaque(in, [&](int i) {
+        unir(couverts, cibles_[i]);
+        unir(menaceurs, attaquants_[i]);
+    });
+    if (intersecte(in, couverts) || intersecte(in, exclus)) return false;  // Conflit interne ou exclusion
+
+    Ensemble interdits = exclus;  // Arguments qui ne peuvent pas rejoindre in
+    unir(interdits, couverts);
+    unir(interdits, menaceurs);
+    unir(interdits, autoAttaques_);
+    Ensemble menaces = sauf(menaceurs, couverts);
+
+    Ensemble candidats{};
+    if (!estVide(menaces)) {
+        int meilleurNb = -1;
+        pourChaque(menaces, [&](int b) {
+            Ensemble defenseurs = sauf(attaquants_[b], interdits);
+            int nb = cardinal(defenseurs);
+            if (meilleurNb == -1 || nb < meilleurNb) {
+                meilleurNb = nb;
+                candidats = defenseurs;
+            }
+        });
+    } else {
+        // in est admissible : il reste à sortir de chaque ensemble à quitter qui le contient
+        size_t k = 0;
+        while (k < nbAQuitter && !inclus(in, aQuitter[k])) ++k;
+        if (k == nbAQuitter) {
+            trouve = in;
+            return true;
+        }
+        candidats = sauf(sauf(tous_, aQuitter[k]), interdits);
+    }
+
+    bool succes = false;
+    pourChaque(candidats, [&](int y) {
+        if (succes) return;
+        Ensemble in2 = in;
+        ajouter(in2, static_cast<size_t>(y));
+        if (chercherAdmissible(in2, exclus, trouve, aQuitter, nbAQuitter)) { succes = true; return; }
+        ajouter(exclus, static_cast<size_t>(y));  // Les branches suivantes excluent y
+    });
+    return succes;
+}
+
+// Ajoute gloutonnement tout argument compatible avec un sur-ensemble admissible, ce qui donne une extension préférée
+template <size_t NbMots>
+typename NoyauCompact<NbMots>::Ensemble NoyauCompact<NbMots>::etendreEnPreferee(Ensemble S, int dernier,
+                                                                                Ensemble exclus) const {
+    auto essayer = [&](size_t x) {
+        if (contient(S, x) || contient(exclus, x)) return;
+        Ensemble candidat = S, trouve{};
+        ajouter(candidat, x);
+        if (chercherAdmissible(candidat, exclus, trouve)) S = trouve;
+    };
+    for (size_t x = 0; x < n_; ++x) {
+        if (static_cast<int>(x) != dernier) essayer(x);
+    }
+    if (dernier >= 0) essayer(static_cast<size_t>(dernier));
+    return S;
+}
+
+// Remonte les attaques par couches jusqu'à ne plus trouver de nouvel attaquant
+template <size_t NbMots>
+typename NoyauCompact<NbMots>::Ensemble NoyauCompact<NbMots>::ancetres(int argId) const {
+    Ensemble cone{}, frontiere{};
+    ajouter(frontiere, static_cast<size_t>(argId));
+    while (!estVide(frontiere)) {
+        unir(cone, frontiere);
+        Ensemble suivants{};
+        pourChaque(frontiere, [&](int x) { unir(suivants, attaquants_[x]); });
+        frontiere = sauf(suivants, cone);
+    }
+    return cone;
+}
+
+// Vérifie si S est une extension stable
+template <size_t NbMots>
+bool NoyauCompact<NbMots>::verifierStable(const Utilitaires::EnsembleIds& S) const {
+    Ensemble e = versEnsemble(S);
+    Ensemble couverts{};
+    pourChaque(e, [&](int i) { unir(couverts, cibles_[i]); });
+    if (intersecte(e, couverts)) return false;  // Pas sans conflit
+    return inclus(sauf(tous_, e), couverts);  // Tout argument extérieur est attaqué
+}
+
+// Vérifie si S est une extension préférée : admissible et sans sur-ensemble admissible strict
+template <size_t NbMots>
+bool NoyauCompact<NbMots>::verifierPreferee(const Utilitaires::EnsembleIds& S,
+                                            std::optional<Utilitaires::EnsembleIds>* temoin) const {
+    Ensemble e = versEnsemble(S);
+    Ensemble couverts{}, menaceurs{};
+    pourChaque(e, [&](int i) {
+        unir(couverts, cibles_[i]);
+        unir(menaceurs, attaquants_[i]);
+    });
+    if (intersecte(e, couverts)) return false;
+    if (!inclus(menaceurs, couverts)) return false;  // Un attaquant n'est pas contré
+
+    bool maximal = true;
+    pourChaque(sauf(tous_, e), [&](int x) {
+        if (!maximal) return;
+        Ensemble candidat = e, trouve{};
+        ajouter(candidat, static_cast<size_t>(x));
+        if (chercherAdmissible(candidat, Ensemble{}, trouve)) {
+            maximal = false;
+            if (temoin) *temoin = versIds(trouve);  // Sur-ensemble admissible strict de S
+        }
+    });
+    return maximal;
+}
+
+// Acceptabilité crédule stable : on force argId à IN
+template <size_t NbMots>
+bool NoyauCompact<NbMots>::credulousStable(int argId, std::optional<Utilitaires::EnsembleIds>* temoin) const {
+    Ensemble in{}, out = autoAttaques_, couverts{}, trouve{};
+    ajouter(in, static_cast<size_t>(argId));
+    unir(couverts, cibles_[argId]);
+    unir(out, attaquants_[argId]);
+    if (!chercherStable(in, out, couverts, trouve)) return false;
+    if (temoin) *temoin = versIds(trouve);
+    return true;
+}
+
+// Acceptabilité crédule préférée : existence d'un ensemble admissible contenant argId
+template <size_t NbMots>
+bool NoyauCompact<NbMots>::credulousPreferred(int argId, std::optional<Utilitaires::EnsembleIds>* temoin) const {
+    Ensemble in{}, trouve{};
+    ajouter(in, static_cast<size_t>(argId));
+    if (!chercherAdmissible(in, Ensemble{}, trouve)) return false;
+    if (temoin) *temoin = versIds(trouve);  // Ensemble admissible contenant argId
+    return true;
+}
+
+// Acceptabilité sceptique stable : crédule, et aucune extension stable ne laisse argId dehors
+// Hors de toute extension stable, argId est refusé et n'importe laquelle le réfute (aucun témoin s'il n'y en a pas)
+template <size_t NbMots>
+bool NoyauCompact<NbMots>::skepticalStable(int argId, std::optional<Utilitaires::EnsembleIds>* temoin) const {
+    if (!credulousStable(argId)) {
+        if (temoin) existeStable(temoin);
+        return false;
+    }
+    Ensemble out = autoAttaques_, trouve{};
+    ajouter(out, static_cast<size_t>(argId));
+    if (!chercherStable(Ensemble{}, out, Ensemble{}, trouve)) return true;
+    if (temoin) *temoin = versIds(trouve);  // Extension stable sans argId
+    return false;
+}
+
+// Acceptabilité sceptique préférée : le cône des ancêtres de argId n'est attaqué par aucun argument extérieur, donc les
+// extensions préférées restreintes au cône sont exactement celles du cône (directionnalité) et la recherche s'y limite
+template <size_t NbMots>
+bool NoyauCompact<NbMots>::skepticalPreferred(int argId, std::optional<Utilitaires::EnsembleIds>* temoin) const {
+    if (!credulousPreferred(argId)) {  // Hors de toute extension préférée : n'importe laquelle le réfute
+        if (temoin) *temoin = extensionPreferee();
+        return false;
+    }
+    Ensemble horsCone = sauf(tous_, ancetres(argId));
+
+    // Un admissible qui attaque argId s'étend en une extension préférée qui l'exclut
+    Ensemble S{};
+    bool contreExemple = false;
+    pourChaque(inter(attaquants_[argId], sauf(tous_, autoAttaques_)), [&](int b) {
+        if (contreExemple) return;
+        Ensemble in{};
+        ajouter(in, static_cast<size_t>(b));
+        contreExemple = chercherAdmissible(in, horsCone, S);
+    });
+
+    // Sinon, chaque nouvel admissible du cône doit sortir de toutes les extensions préférées du cône déjà trouvées,
+    // ce qui garantit que son extension maximale dans le cône est nouvelle
+    std::vector<Ensemble> trouvees;
+    while (!contreExemple && chercherAdmissible(Ensemble{}, horsCone, S, trouvees.data(), trouvees.size())) {
+        Ensemble E = etendreEnPreferee(S, argId, horsCone);
+        if (!contient(E, static_cast<size_t>(argId))) {  // Contre-exemple trouvé dans le cône
+            S = E;
+            contreExemple = true;
+            break;
+        }
+        trouvees.push_back(E);
+    }
+    if (!contreExemple) return true;
+    // Étendue au système entier, une préférée du cône sans argId reste une préférée sans argId
+    if (temoin) *temoin = versIds(etendreEnPreferee(S, argId));
+    return false;
+}
+
+// Existence d'une extension stable : recherche sans contrainte initiale
+template <size_t NbMots>
+bool NoyauCompact<NbMots>::existeStable(std::optional<Utilitaires::EnsembleIds>* temoin) const {
+    Ensemble trouve{};
+    if (!chercherStable(Ensemble{}, autoAttaques_, Ensemble{}, trouve)) return false;
+    if (temoin) *temoin = versIds(trouve);
+    return true;
+}
+
+// Extension préférée : l'ensemble vide est admissible
+template <size_t NbMots>
+Utilitaires::EnsembleIds NoyauCompact<NbMots>::extensionPreferee() const {
+    return versIds(etendreEnPreferee(Ensemble{}, -1));
+}
+
+
+template class NoyauCompact<1>;
+template class NoyauCompact<2>;
+template class NoyauCompact<4>;
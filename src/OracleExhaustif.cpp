@@ -0,0 +1,225 @@
+/* OracleExhaustif.cpp
+ * Énumération des sous-ensembles par blocs : la moitié basse des bits parcourt un bloc contigu dont les unions de
+ * lignes d'attaque sont précalculées, la moitié haute est fixée par bloc et distribuée aux threads. */
+
+#include "OracleExhaustif.hpp"
+#include "Utilitaires.hpp"
+#include <algorithm>  // std::sort, std::min, std::max
+#include <atomic>  // std::atomic
+#include <functional>  // std::ref
+#include <string>  // std::string
+#include <thread>  // std::thread
+#include <utility>  // std::pair
+
+
+namespace {
+    using OracleExhaustif::Masque;
+    using std::vector;
+
+    // Nombre maximal de bits parcourus à l'intérieur d'un bloc (tables de 2^16 entrées, 256 Ko chacune)
+    constexpr size_t BITS_BLOC = 16;
+    // Drapeaux calculés pour chaque sous-ensemble d'un bloc
+    constexpr uint8_t ADMISSIBLE = 1, STABLE = 2;
+
+    // Extensions trouvées par un thread
+    struct Trouvees {
+        uint64_t nbAdmissibles = 0;
+        vector<Masque> completes, stables;
+    };
+
+    // Union des lignes de chaque sous-ensemble L des nbBits premiers arguments : table[L] = table[L sans son bit de
+    // poids faible] | ligne de ce bit
+    vector<Masque> tableUnions(const vector<Masque>& lignes, size_t nbBits) {
+        vector<Masque> table(size_t(1) << nbBits, 0);
+        for (size_t L = 1; L < table.size(); ++L) {
+            table[L] = table[L & (L - 1)] | lignes[__builtin_ctzll(L)];
+        }
+        return table;
+    }
+
+    // Vrai si tous les arguments défendus par l'ensemble admissible S (d'image attaques) sont dans S : un argument
+    // défendu n'est jamais attaqué par S, seuls les autres sont examinés
+    bool estComplete(Masque S, Masque attaques, Masque tous, const vector<Masque>& attaquants) {
+        Masque candidats = tous & ~S & ~attaques;
+        while (candidats) {
+            int a = __builtin_ctz(candidats);
+            if ((attaquants[a] & ~attaques) == 0) return false;
+            candidats &= candidats - 1;
+        }
+        return true;
+    }
+}
+
+
+namespace OracleExhaustif {
+
+bool estApplicable(const SystemeArgumentation& sa) {
+    return sa.getNbArguments() <= CAPACITE;
+}
+
+Bilan enumerer(const SystemeArgumentation& sa, size_t nbThreads) {
+    size_t n = sa.getNbArguments();
+    Masque tous = n == CAPACITE ? ~Masque(0) : (Masque(1) << n) - 1;
+    vector<Masque> cibles(n, 0), attaquants(n, 0);
+    const auto& adjacence = sa.getAdjacence();
+    for (size_t u = 0; u < n; ++u) {
+        for (int v : adjacence[u]) {
+            cibles[u] |= Masque(1) << v;
+            attaquants[v] |= Masque(1) << u;
+        }
+    }
+
+    // Un sous-ensemble S = (H << bitsBas) | L : les unions sur L viennent des tables, celles sur H sont faites par bloc
+    size_t bitsBas = std::min(n, BITS_BLOC);
+    size_t nbBlocs = size_t(1) << (n - bitsBas);
+    vector<Masque> ciblesBas = tableUnions(cibles, bitsBas);
+    vector<Masque> attaquantsBas = tableUnions(attaquants, bitsBas);
+
+    if (nbThreads == 0) nbThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    nbThreads = std::min(nbThreads, nbBlocs);
+    vector<Trouvees> parThread(nbThreads);
+    std::atomic<size_t> suivant{0};
+    auto travailler = [&](Trouvees& trouvees) {
+        vector<uint8_t> drapeaux(ciblesBas.size());
+        for (size_t H = suivant++; H < nbBlocs; H = suivant++) {
+            Masque haut = static_cast<Masque>(H << bitsBas), ciblesHaut = 0, attaquantsHaut = 0;
+            for (size_t i = bitsBas; i < n; ++i) {
+                if ((haut >> i) & 1) {
+                    ciblesHaut |= cibles[i];
+                    attaquantsHaut |= attaquants[i];
+                }
+            }
+            // Boucle sans branchement sur le bloc, vectorisée par le compilateur : opérations de masques seulement
+            for (size_t L = 0; L < drapeaux.size(); ++L) {
+                Masque S = haut | static_cast<Masque>(L);
+                Masque attaques = ciblesHaut | ciblesBas[L];
+                Masque attaquantsS = attaquantsHaut | attaquantsBas[L];
+                bool sansConflit = (attaques & S) == 0;
+                bool admissible = sansConflit && (attaquantsS & ~attaques) == 0;
+                bool stable = sansConflit && (S | attaques) == tous;
+                drapeaux[L] = static_cast<uint8_t>(admissible * ADMISSIBLE | stable * STABLE);
+            }
+            for (size_t L = 0; L < drapeaux.size(); ++L) {
+                if (!(drapeaux[L] & ADMISSIBLE)) continue;
+                Masque S = haut | static_cast<Masque>(L);
+                Masque attaques = ciblesHaut | ciblesBas[L];
+                ++trouvees.nbAdmissibles;
+                if (drapeaux[L] & STABLE) trouvees.stables.push_back(S);
+                if (estComplete(S, attaques, tous, attaquants)) trouvees.completes.push_back(S);
+            }
+        }
+    };
+    vector<std::thread> threads;
+    for (size_t t = 1; t < nbThreads; ++t) threads.emplace_back(travailler, std::ref(parThread[t]));
+    travailler(parThread[0]);
+    for (auto& thread : threads) thread.join();
+
+    Bilan bilan;
+    bilan.nbArguments = n;
+    for (Trouvees& trouvees : parThread) {
+        bilan.nbAdmissibles += trouvees.nbAdmissibles;
+        bilan.completes.insert(bilan.completes.end(), trouvees.completes.begin(), trouvees.completes.end());
+        bilan.stables.insert(bilan.stables.end(), trouvees.stables.begin(), trouvees.stables.end());
+    }
+
+    // Préférées : complètes maximales, retenues par cardinal décroissant si aucune déjà retenue ne les contient
+    vector<Masque> parCardinal = bilan.completes;
+    std::sort(parCardinal.begin(), parCardinal.end(), [](Masque a, Masque b) {
+        int ca = __builtin_popcount(a), cb = __builtin_popcount(b);
+        return ca != cb ? ca > cb : a < b;
+    });
+    for (Masque S : parCardinal) {
+        bool contenue = false;
+        for (Masque P : bilan.preferees) contenue |= (S & ~P) == 0;
+        if (!contenue) bilan.preferees.push_back(S);
+    }
+    std::sort(bilan.completes.begin(), bilan.completes.end());
+    std::sort(bilan.preferees.begin(), bilan.preferees.end());
+    std::sort(bilan.stables.begin(), bilan.stables.end());
+
+    bilan.fondee = tous;
+    for (Masque S : bilan.completes) bilan.fondee &= S;
+    bilan.sceptiquePreferee = tous;
+    for (Masque S : bilan.preferees) {
+        bilan.credulePreferee |= S;
+        bilan.sceptiquePreferee &= S;
+    }
+    bilan.sceptiqueStable = bilan.stables.empty() ? 0 : tous;
+    for (Masque S : bilan.stables) {
+        bilan.creduleStable |= S;
+        bilan.sceptiqueStable &= S;
+    }
+    return bilan;
+}
+
+bool repondre(const Bilan& bilan, TypeProbleme probleme, Masque requete) {
+    switch (probleme) {
+        case TypeProbleme::VE_PR:
+            return std::binary_search(bilan.preferees.begin(), bilan.preferees.end(), requete);
+        case TypeProbleme::VE_ST:
+            return std::binary_search(bilan.stables.begin(), bilan.stables.end(), requete);
+        case TypeProbleme::DC_PR:
+        case TypeProbleme::DC_CO:
+            return (bilan.credulePreferee & requete) != 0;
+        case TypeProbleme::DS_PR:
+            return (bilan.sceptiquePreferee & requete) != 0;
+        case TypeProbleme::DC_ST:
+            return (bilan.creduleStable & requete) != 0;
+        case TypeProbleme::DS_ST:
+            return (bilan.sceptiqueStable & requete) != 0;
+        case TypeProbleme::DC_GR:
+        case TypeProbleme::DS_GR:
+        case TypeProbleme::DS_CO:
+            return (bilan.fondee & requete) != 0;
+        case TypeProbleme::SE_GR:
+            return true;
+        case TypeProbleme::SE_ST:
+            return !bilan.stables.empty();
+        default:
+            return false;
+    }
+}
+
+uint64_t compter(const Bilan& bilan, TypeProbleme probleme, Masque requete) {
+    const vector<Masque>& extensions = probleme == TypeProbleme::CE_ST ? bilan.stables : bilan.preferees;
+    uint64_t total = 0;
+    for (Masque S : extensions) total += (S & requete) == requete;
+    return total;
+}
+
+std::vector<int> versIds(Masque masque) {
+    std::vector<int> ids;
+    for (; masque; masque &= masque - 1) ids.push_back(__builtin_ctz(masque));
+    return ids;
+}
+
+void afficher(const Bilan& bilan, const SystemeArgumentation& sa, std::ostream& sortie) {
+    // Même format que les réponses SE-GR : [a,b,c] dans l'ordre de déclaration
+    auto ensemble = [&](Masque S) {
+        std::string texte = "[";
+        for (const std::string& nom : Utilitaires::convertirIdsEnNoms(versIds(S), sa)) {
+            texte += (texte.size() > 1 ? "," : "") + nom;
+        }
+        return texte + "]";
+    };
+    auto liste = [&](const char* titre, const vector<Masque>& extensions) {
+        sortie << titre << " (" << extensions.size() << ") :";
+        for (Masque S : extensions) sortie << ' ' << ensemble(S);
+        sortie << '\n';
+    };
+    sortie << "Arguments : " << bilan.nbArguments << '\n';
+    sortie << "Ensembles admissibles : " << bilan.nbAdmissibles << '\n';
+    liste("Extensions complètes", bilan.completes);
+    liste("Extensions préférées", bilan.preferees);
+    liste("Extensions stables", bilan.stables);
+    sortie << "Extension fondée : " << ensemble(bilan.fondee) << '\n';
+    const std::pair<const char*, Masque> taches[] = {
+        {"DC-PR", bilan.credulePreferee}, {"DS-PR", bilan.sceptiquePreferee},
+        {"DC-ST", bilan.creduleStable}, {"DS-ST", bilan.sceptiqueStable},
+        {"DC-CO", bilan.credulePreferee}, {"DS-CO", bilan.fondee},
+        {"DC-GR", bilan.fondee}, {"DS-GR", bilan.fondee}
+    };
+    for (const auto& [nom, acceptes] : taches) sortie << nom << " : " << ensemble(acceptes) << '\n';
+}
+
+}
@@ -2,26 +2,649 @@
  * Module responsable de l'analyse syntaxique des fichiers .apx pour construire le système d'argumentation. */
 
 #include "Parseur.hpp"
+#include "CompteurMemoire.hpp"
 #include <fstream>  // std::ifstream
 #include <sstream>  // std::stringstream
-#include <algorithm>  // std::remove_if, std::all_of
+#include <algorithm>  // std::remove_if, std::all_of, std::sort, std::min
+#include <atomic>  // std::atomic
+#include <charconv>  // std::from_chars
+#include <condition_variable>  // std::condition_variable
+#include <deque>  // std::deque
+#include <mutex>  // std::mutex, std::unique_lock
+#include <thread>  // std::thread
+#include <limits>  // std::numeric_limits
+#include <vector>  // std::vector
+#include <cerrno>  // errno, EINTR
+#include <poll.h>  // poll
+#include <unistd.h>  // read, write, pipe, close, STDIN_FILENO
 
 
-// Fonction principale : lecture ligne par ligne et du remplissage du système
+// Tampons remplis par l'analyse d'un bloc, les noms sont des vues dans le contenu du fichier
+struct Parseur::BlocAnalyse {
+    struct Argument { std::string_view nom; size_t ligne; };
+    struct Attaque { std::string_view source, cible; size_t ligne; };
+
+    std::vector<Argument> arguments;
+    std::vector<Attaque> attaques;
+    size_t nbLignes = 0;  // Nombre de lignes du bloc
+    size_t ligneErreur = 0;  // Première ligne invalide (locale au bloc, 0 si aucune)
+    std::string messageErreur;
+    bool prefixerLigne = false;  // Le message doit être précédé de "Ligne N : "
+};
+
+// État de l'analyse d'un flux : les arguments sont enregistrés dès leur ligne, les attaques résolues en identifiants
+// et les degrés tenus à jour, de sorte qu'à la fin du flux il ne reste qu'à remplir les listes d'attaques
+struct Parseur::AnalyseFlux {
+    enum class Format { INCONNU, APX, NUMERIQUE };
+
+    Format format = Format::INCONNU;  // Fixé par la première ligne significative
+    SystemeArgumentation systeme;
+    std::vector<std::pair<int, int>> attaques;  // Attaques (source, cible) dans l'ordre du flux, doublons compris
+    std::vector<size_t> lignes;  // Ligne de chaque attaque
+    // Texte des lignes d'attaque écrites autrement que sous leur forme canonique ("att(a,b)." ou "1 2"), par indice
+    // d'attaque croissant : seul le message d'un doublon en a besoin, les lignes canoniques se réécrivent à l'identique
+    std::vector<std::pair<size_t, std::string>> textesAtypiques;
+    std::vector<size_t> nbCibles, nbAttaquants;  // Degrés sortant et entrant de chaque argument
+    size_t numeroLigne = 0;  // Dernière ligne analysée
+    size_t ligneErreur = 0;  // Première ligne invalide (0 si aucune)
+    std::string messageErreur;
+
+    // Vrai si la première ligne significative du contenu est un en-tête "p af N"
+    static bool commenceParEnTete(std::string_view contenu);
+    // Analyse une suite de lignes complètes ; sans effet après la première erreur
+    void analyserLignes(std::string_view texte);
+    // Analyse une ligne débarrassée de ses espaces, dans le format du flux
+    void analyserLigne(std::string_view ligne);
+    // Analyse une ligne du format numérique : en-tête "p af N" puis une attaque "source cible" par ligne
+    void analyserLigneNumerique(std::string_view ligne);
+    // Enregistre un nouvel argument et ses compteurs de degrés
+    void ajouterArgument(std::string_view nom);
+    // Enregistre une attaque entre deux identifiants existants, ligne étant le texte débarrassé de ses espaces
+    void ajouterAttaque(int source, int cible, std::string_view ligne);
+    // Texte de la ligne de l'attaque d'indice donné, tel qu'il figurait dans le flux
+    std::string texteAttaque(size_t indice) const;
+    // Retient la première erreur, le message étant précédé de "Ligne N : "
+    void signalerErreur(const std::string& message);
+    // Remplit les listes d'attaques, contrôle les doublons et retourne le système, ou lance l'erreur la plus tôt
+    SystemeArgumentation finaliser(const std::string& nomSource);
+};
+
+namespace {
+    constexpr size_t AUCUNE_LIGNE = std::numeric_limits<size_t>::max();
+    // En dessous de cette taille par bloc, le coût des threads dépasse le gain
+    constexpr size_t TAILLE_BLOC_MIN = size_t(1) << 20;
+    // Nombre de paquets d'arguments pour la répartition des attaques entre threads
+    constexpr size_t NB_PAQUETS_MAX = 4096;
+    // Taille des blocs lus dans un flux, et nombre de blocs lus d'avance au plus
+    constexpr size_t TAILLE_LECTURE = size_t(1) << 20;
+    constexpr size_t BLOCS_EN_ATTENTE = 4;
+
+    // Attaque dont les arguments ont été résolus en identifiants
+    struct AttaqueResolue { int source, cible; size_t ligne; };
+
+    // Exécute fonction(i) pour i dans [0, nbTaches) sur au plus nbThreads threads (sur place si un seul)
+    // Les threads héritent de la phase mémoire de l'appelant
+    template <typename Fonction>
+    void executerEnParallele(size_t nbTaches, size_t nbThreads, Fonction&& fonction) {
+        nbThreads = std::min(nbThreads, nbTaches);
+        if (nbThreads <= 1) {
+            for (size_t i = 0; i < nbTaches; ++i) fonction(i);
+            return;
+        }
+        std::atomic<size_t> suivante{0};
+        std::vector<std::thread> threads;
+        CompteurMemoire::Phase phase = CompteurMemoire::phaseCourante();
+        for (size_t t = 0; t < nbThreads; ++t) {
+            threads.emplace_back([&]() {
+                CompteurMemoire::PorteePhase portee(phase);
+                for (size_t i = suivante++; i < nbTaches; i = suivante++) fonction(i);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    }
+
+    // Lit un entier positif en tête de texte (espaces initiaux ignorés) et le retire du texte
+    bool lireEntier(std::string_view& texte, size_t& valeur) {
+        while (!texte.empty() && std::isspace(static_cast<unsigned char>(texte.front()))) texte.remove_prefix(1);
+        auto [fin, erreur] = std::from_chars(texte.data(), texte.data() + texte.size(), valeur);
+        if (erreur != std::errc() || fin == texte.data()) return false;
+        texte.remove_prefix(static_cast<size_t>(fin - texte.data()));
+        return true;
+    }
+
+    // Nombre de chiffres de l'écriture décimale d'un entier
+    size_t nbChiffres(size_t valeur) {
+        size_t chiffres = 1;
+        for (; valeur >= 10; valeur /= 10) ++chiffres;
+        return chiffres;
+    }
+
+    // Retrouve le texte (débarrassé des espaces) de la ligne donnée, utilisé seulement pour les messages d'erreur
+    std::string_view extraireLigne(std::string_view contenu, size_t numero) {
+        size_t debut = 0;
+        for (size_t ligne = 1; ligne < numero && debut < contenu.size(); ++ligne) {
+            size_t fin = contenu.find('\n', debut);
+            debut = (fin == std::string_view::npos) ? contenu.size() : fin + 1;
+        }
+        size_t fin = contenu.find('\n', debut);
+        std::string_view texte = contenu.substr(debut, fin == std::string_view::npos ? std::string_view::npos : fin - debut);
+        while (!texte.empty() && std::isspace(static_cast<unsigned char>(texte.front()))) texte.remove_prefix(1);
+        while (!texte.empty() && std::isspace(static_cast<unsigned char>(texte.back()))) texte.remove_suffix(1);
+        return texte;
+    }
+
+    // Répartit les attaques (dans l'ordre du fichier) en paquets selon cle(attaque) / taillePaquet
+    // Chaque bloc écrit dans sa propre plage de chaque paquet, ce qui conserve l'ordre du fichier dans un paquet
+    template <typename Cle>
+    std::vector<AttaqueResolue> repartirParPaquets(const std::vector<std::vector<AttaqueResolue>>& parBloc,
+        size_t nbPaquets, size_t taillePaquet, size_t nbThreads, std::vector<size_t>& debutsPaquets, Cle&& cle) {
+        size_t nbBlocs = parBloc.size();
+        std::vector<std::vector<size_t>> comptes(nbBlocs, std::vector<size_t>(nbPaquets, 0));
+        executerEnParallele(nbBlocs, nbThreads, [&](size_t b) {
+            for (const auto& attaque : parBloc[b]) ++comptes[b][cle(attaque) / taillePaquet];
+        });
+
+        // Somme préfixe dans l'ordre (paquet, bloc) : positions d'écriture de chaque bloc dans chaque paquet
+        debutsPaquets.assign(nbPaquets + 1, 0);
+        size_t position = 0;
+        for (size_t p = 0; p < nbPaquets; ++p) {
+            debutsPaquets[p] = position;
+            for (size_t b = 0; b < nbBlocs; ++b) {
+                size_t nb = comptes[b][p];
+                comptes[b][p] = position;
+                position += nb;
+            }
+        }
+        debutsPaquets[nbPaquets] = position;
+
+        std::vector<AttaqueResolue> resultat(position);
+        executerEnParallele(nbBlocs, nbThreads, [&](size_t b) {
+            for (const auto& attaque : parBloc[b]) resultat[comptes[b][cle(attaque) / taillePaquet]++] = attaque;
+        });
+        return resultat;
+    }
+}
+
+// Lecture d'un flux par un thread dédié, en blocs d'au plus TAILLE_LECTURE octets : au plus BLOCS_EN_ATTENTE blocs
+// attendent leur analyse, ce qui borne la mémoire de lecture quelle que soit la taille du flux.
+// Sur un descripteur, le lecteur attend les données avec poll et s'interrompt dès que le consommateur abandonne
+// (erreur de syntaxe) ; un std::istream ne peut être interrompu qu'entre deux lectures
+class Parseur::LecteurFlux {
+private:
+    std::istream* flux_ = nullptr;
+    int descripteur_ = -1;
+    int reveil_[2] = {-1, -1};  // Tube écrit par le destructeur pour réveiller poll
+    std::mutex mutex_;
+    std::condition_variable changement_;
+    std::deque<std::string> blocs_;
+    bool fin_ = false;  // Le lecteur a terminé (fin du flux, erreur ou arrêt demandé)
+    bool erreur_ = false;  // Le flux a signalé une erreur de lecture
+    bool arret_ = false;  // Le consommateur n'attend plus rien
+    std::thread thread_;
+
+    // Remplit le bloc avec la lecture suivante ; retourne false à la fin du flux, sur une erreur ou un arrêt
+    bool lireBloc(std::string& bloc) {
+        if (flux_) {
+            flux_->read(&bloc[0], static_cast<std::streamsize>(bloc.size()));
+            bloc.resize(static_cast<size_t>(flux_->gcount()));
+            if (flux_->bad()) erreur_ = true;
+            return static_cast<bool>(*flux_);
+        }
+        pollfd attente[2] = {{descripteur_, POLLIN, 0}, {reveil_[0], POLLIN, 0}};
+        while (true) {
+            if (poll(attente, 2, -1) < 0) {
+                if (errno == EINTR) continue;
+                erreur_ = true;
+                break;
+            }
+            if (attente[1].revents != 0) break;  // Arrêt demandé par le destructeur
+            ssize_t lus = read(descripteur_, &bloc[0], bloc.size());
+            if (lus < 0) {
+                if (errno == EINTR || errno == EAGAIN) continue;
+                erreur_ = true;
+                break;
+            }
+            if (lus == 0) break;  // Fin du flux
+            bloc.resize(static_cast<size_t>(lus));
+            return true;
+        }
+        bloc.clear();
+        return false;
+    }
+
+    // Boucle du thread lecteur, qui hérite de la phase mémoire du consommateur
+    void lire(CompteurMemoire::Phase phase) {
+        CompteurMemoire::PorteePhase portee(phase);
+        bool termine = false;
+        while (!termine) {
+            std::string bloc(TAILLE_LECTURE, '\0');
+            termine = !lireBloc(bloc);
+            std::unique_lock<std::mutex> verrou(mutex_);
+            changement_.wait(verrou, [&]() { return arret_ || blocs_.size() < BLOCS_EN_ATTENTE; });
+            if (arret_) break;
+            if (!bloc.empty()) blocs_.push_back(std::move(bloc));
+            changement_.notify_all();
+        }
+        std::lock_guard<std::mutex> verrou(mutex_);
+        fin_ = true;
+        changement_.notify_all();
+    }
+
+    void demarrer() {
+        thread_ = std::thread(&LecteurFlux::lire, this, CompteurMemoire::phaseCourante());
+    }
+
+public:
+    explicit LecteurFlux(std::istream& flux) : flux_(&flux) {
+        demarrer();
+    }
+    explicit LecteurFlux(int descripteur) : descripteur_(descripteur) {
+        if (pipe(reveil_) != 0) throw ErreurParsing("Impossible de préparer la lecture du flux");
+        demarrer();
+    }
+    // Arrête le lecteur : immédiatement sur un descripteur, après sa lecture en cours sur un std::istream
+    ~LecteurFlux() {
+        {
+            std::lock_guard<std::mutex> verrou(mutex_);
+            arret_ = true;
+        }
+        changement_.notify_all();
+        if (reveil_[1] >= 0) {
+            char signal = 0;
+            while (write(reveil_[1], &signal, 1) < 0 && errno == EINTR) {}
+        }
+        thread_.join();
+        for (int extremite : reveil_) {
+            if (extremite >= 0) close(extremite);
+        }
+    }
+    LecteurFlux(const LecteurFlux&) = delete;
+    LecteurFlux& operator=(const LecteurFlux&) = delete;
+
+    // Attend le bloc suivant ; retourne false à la fin du flux, lance ErreurParsing sur une erreur de lecture
+    bool suivant(std::string& bloc) {
+        std::unique_lock<std::mutex> verrou(mutex_);
+        changement_.wait(verrou, [&]() { return fin_ || !blocs_.empty(); });
+        if (blocs_.empty()) {
+            if (erreur_) throw ErreurParsing("Erreur de lecture du flux");
+            return false;
+        }
+        bloc = std::move(blocs_.front());
+        blocs_.pop_front();
+        changement_.notify_all();
+        return true;
+    }
+};
+
+
+// Fonction principale : lecture du fichier entier en mémoire puis analyse
 SystemeArgumentation Parseur::parserFichier(const std::string& cheminFichier) {
-    std::ifstream fichier(cheminFichier); // Ouverture du flux en lecture
+    if (cheminFichier == "-") return parserDescripteur(STDIN_FILENO, "<entrée standard>");
+    std::ifstream fichier(cheminFichier, std::ios::binary); // Ouverture du flux en lecture
     if (!fichier.is_open()) {
         throw ErreurParsing("Impossible d'ouvrir le fichier : " + cheminFichier);
     }
+    std::stringstream tampon;
+    tampon << fichier.rdbuf();
+    fichier.close();
+    std::string contenu = tampon.str();
+    return parserTampon(contenu, cheminFichier);
+}
 
-    SystemeArgumentation systeme;  // Le système d'argumentation qu'on va construire
-    std::string ligne;  // Pour stocker chaque ligne lue
-    size_t numeroLigne = 0;  // Pour indiquer l'emplacement exact de l'erreur
+// Analyse en deux phases : blocs de lignes analysés en parallèle, puis fusion (identifiants, adjacence)
+SystemeArgumentation Parseur::parserTampon(std::string_view contenu, const std::string& nomSource) {
+    // Le format numérique, plus simple à analyser, passe par l'analyse incrémentale sur le contenu entier
+    if (AnalyseFlux::commenceParEnTete(contenu)) {
+        AnalyseFlux analyse;
+        analyse.analyserLignes(contenu);
+        return analyse.finaliser(nomSource);
+    }
+    size_t nbThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+    // 1 - Découpage aux fins de ligne en au plus nbThreads blocs d'au moins TAILLE_BLOC_MIN octets
+    size_t nbBlocsVises = std::max<size_t>(1, std::min(nbThreads, contenu.size() / TAILLE_BLOC_MIN));
+    std::vector<std::string_view> blocs;
+    size_t debut = 0;
+    for (size_t b = 1; b <= nbBlocsVises && debut < contenu.size(); ++b) {
+        size_t fin = contenu.size();
+        if (b < nbBlocsVises) {
+            fin = contenu.find('\n', std::max(debut, contenu.size() * b / nbBlocsVises));
+            fin = (fin == std::string_view::npos) ? contenu.size() : fin + 1;
+        }
+        blocs.push_back(contenu.substr(debut, fin - debut));
+        debut = fin;
+    }
+
+    // 2 - Analyse syntaxique concurrente de chaque bloc
+    std::vector<BlocAnalyse> analyses(blocs.size());
+    executerEnParallele(blocs.size(), nbThreads, [&](size_t b) { analyserBloc(blocs[b], analyses[b]); });
+
+    // Numéro global de la première ligne de chaque bloc, et première erreur de syntaxe
+    std::vector<size_t> premiereLigne(blocs.size());
+    size_t ligneSyntaxe = AUCUNE_LIGNE;  // Première ligne mal formée
+    std::string messageSyntaxe;
+    size_t ligneCourante = 0;
+    for (size_t b = 0; b < blocs.size(); ++b) {
+        premiereLigne[b] = ligneCourante;
+        if (analyses[b].ligneErreur != 0 && ligneSyntaxe == AUCUNE_LIGNE) {
+            ligneSyntaxe = ligneCourante + analyses[b].ligneErreur;
+            messageSyntaxe = analyses[b].prefixerLigne
+                ? "Ligne " + std::to_string(ligneSyntaxe) + " : " + analyses[b].messageErreur
+                : analyses[b].messageErreur;
+        }
+        ligneCourante += analyses[b].nbLignes;
+    }
+    size_t limite = ligneSyntaxe;  // Première ligne fautive du fichier, toutes causes confondues
+
+    // 3 - Attribution des identifiants dans l'ordre du fichier (les redéclarations sont ignorées)
+    SystemeArgumentation systeme;
+    std::vector<size_t> ligneDeclaration;  // Ligne de déclaration de chaque identifiant
+    size_t nbDeclarations = 0, tailleNoms = 0;
+    for (const auto& analyse : analyses) {
+        nbDeclarations += analyse.arguments.size();
+        for (const auto& argument : analyse.arguments) tailleNoms += argument.nom.size();
+    }
+    systeme.reserver(nbDeclarations, tailleNoms);
+    ligneDeclaration.reserve(nbDeclarations);
+    for (size_t b = 0; b < blocs.size(); ++b) {
+        for (const auto& argument : analyses[b].arguments) {
+            size_t ligne = premiereLigne[b] + argument.ligne;
+            if (ligne >= limite) break;
+            if (systeme.ajouterArgument(argument.nom)) ligneDeclaration.push_back(ligne);
+        }
+    }
+
+    // 4 - Résolution concurrente des attaques : les deux arguments doivent être déclarés sur une ligne antérieure
+    std::vector<std::vector<AttaqueResolue>> resolues(blocs.size());
+    std::vector<size_t> premiereInvalide(blocs.size(), AUCUNE_LIGNE);
+    executerEnParallele(blocs.size(), nbThreads, [&](size_t b) {
+        resolues[b].reserve(analyses[b].attaques.size());
+        for (const auto& attaque : analyses[b].attaques) {
+            size_t ligne = premiereLigne[b] + attaque.ligne;
+            int u = systeme.trouverId(attaque.source);
+            int v = systeme.trouverId(attaque.cible);
+            if (u == -1 || v == -1 || ligneDeclaration[u] > ligne || ligneDeclaration[v] > ligne) {
+                premiereInvalide[b] = ligne;
+                break;
+            }
+            resolues[b].push_back({u, v, ligne});
+        }
+    });
+    for (size_t ligne : premiereInvalide) limite = std::min(limite, ligne);
+
+    // 5 - Tri par comptage en parallèle selon la source : chaque paquet de sources est traité par un seul thread
+    //     qui détecte les doublons et remplit les listes d'adjacence dans l'ordre du fichier
+    for (auto& liste : resolues) {
+        while (!liste.empty() && liste.back().ligne >= limite) liste.pop_back();
+    }
+    size_t n = systeme.getNbArguments();
+    size_t nbPaquets = std::max<size_t>(1, std::min(n, NB_PAQUETS_MAX));
+    size_t taillePaquet = (n + nbPaquets - 1) / nbPaquets;
+    std::vector<size_t> debutsPaquets;
+    std::vector<std::vector<int>> adjacence(n), parents(n);
+
+    std::vector<AttaqueResolue> parSource = repartirParPaquets(resolues, nbPaquets, taillePaquet, nbThreads,
+        debutsPaquets, [](const AttaqueResolue& a) { return static_cast<size_t>(a.source); });
+    std::vector<size_t> premierDoublon(nbPaquets, AUCUNE_LIGNE);
+    executerEnParallele(nbPaquets, nbThreads, [&](size_t p) {
+        auto debutPaquet = parSource.begin() + debutsPaquets[p];
+        auto finPaquet = parSource.begin() + debutsPaquets[p + 1];
+        // Une attaque répétée est rejetée à sa seconde occurrence, comme par ajouterAttaque
+        std::vector<AttaqueResolue> triees(debutPaquet, finPaquet);
+        std::sort(triees.begin(), triees.end(), [](const AttaqueResolue& a, const AttaqueResolue& b) {
+            if (a.source != b.source) return a.source < b.source;
+            if (a.cible != b.cible) return a.cible < b.cible;
+            return a.ligne < b.ligne;
+        });
+        for (size_t i = 1; i < triees.size(); ++i) {
+            if (triees[i].source == triees[i - 1].source && triees[i].cible == triees[i - 1].cible) {
+                premierDoublon[p] = std::min(premierDoublon[p], triees[i].ligne);
+            }
+        }
+        for (auto it = debutPaquet; it != finPaquet; ++it) adjacence[it->source].push_back(it->cible);
+    });
+    for (size_t ligne : premierDoublon) limite = std::min(limite, ligne);
+
+    // Si une ligne est fautive, on la signale avec le même message que l'analyse séquentielle
+    if (limite != AUCUNE_LIGNE) {
+        std::string message = (limite == ligneSyntaxe) ? messageSyntaxe
+            : "Ligne " + std::to_string(limite) + " : Attaque invalide (arguments inexistants) : " +
+              std::string(extraireLigne(contenu, limite));
+        throw ErreurParsing("Erreur de parsing dans '" + nomSource +
+            "' ligne " + std::to_string(limite) + " : " + message);
+    }
+
+    // 6 - Même répartition selon la cible pour les listes de parents
+    std::vector<AttaqueResolue> parCible = repartirParPaquets(resolues, nbPaquets, taillePaquet, nbThreads,
+        debutsPaquets, [](const AttaqueResolue& a) { return static_cast<size_t>(a.cible); });
+    executerEnParallele(nbPaquets, nbThreads, [&](size_t p) {
+        for (size_t i = debutsPaquets[p]; i < debutsPaquets[p + 1]; ++i) {
+            parents[parCible[i].cible].push_back(parCible[i].source);
+        }
+    });
+    systeme.remplacerAttaques(std::move(adjacence), std::move(parents));
+
+    if (systeme.getNbArguments() == 0) {  // Vérifier qu'on a au moins un argument
+        throw ErreurParsing("Le fichier '" + nomSource +"' ne contient aucun argument valide");
+    }
+    return systeme;
+}
+
+SystemeArgumentation Parseur::parserFlux(std::istream& flux, const std::string& nomSource) {
+    LecteurFlux lecteur(flux);
+    return analyserFlux(lecteur, nomSource);
+}
+
+SystemeArgumentation Parseur::parserDescripteur(int descripteur, const std::string& nomSource) {
+    LecteurFlux lecteur(descripteur);
+    return analyserFlux(lecteur, nomSource);
+}
+
+// Analyse au fil de la lecture : les lignes complètes de chaque bloc sont analysées pendant que le suivant est lu,
+// le début de la dernière ligne d'un bloc attend la fin de celle-ci dans le bloc suivant. Après une erreur, le
+// lecteur est abandonné sans attendre la fin du flux
+SystemeArgumentation Parseur::analyserFlux(LecteurFlux& lecteur, const std::string& nomSource) {
+    AnalyseFlux analyse;
+    std::string bloc, reste;
+    while (analyse.ligneErreur == 0 && lecteur.suivant(bloc)) {
+        size_t premiere = bloc.find('\n');
+        if (premiere == std::string::npos) {
+            reste += bloc;
+            continue;
+        }
+        reste.append(bloc, 0, premiere + 1);
+        analyse.analyserLignes(reste);
+        size_t derniere = bloc.rfind('\n');
+        analyse.analyserLignes(std::string_view(bloc).substr(premiere + 1, derniere - premiere));
+        reste.assign(bloc, derniere + 1, std::string::npos);
+    }
+    analyse.analyserLignes(reste);
+    return analyse.finaliser(nomSource);
+}
 
-    // Lecture séquentielle du fichier
-    while (std::getline(fichier, ligne)) {
+bool Parseur::AnalyseFlux::commenceParEnTete(std::string_view contenu) {
+    size_t debut = 0;
+    while (debut < contenu.size()) {
+        size_t fin = contenu.find('\n', debut);
+        if (fin == std::string_view::npos) fin = contenu.size();
+        std::string_view ligne = trim(contenu.substr(debut, fin - debut));
+        debut = fin + 1;
+        if (ligne.empty() || ligne[0] == '#') continue;
+        return ligne.size() > 1 && ligne[0] == 'p' && std::isspace(static_cast<unsigned char>(ligne[1]));
+    }
+    return false;
+}
+
+void Parseur::AnalyseFlux::analyserLignes(std::string_view texte) {
+    size_t debut = 0;
+    while (debut < texte.size() && ligneErreur == 0) {
+        size_t fin = texte.find('\n', debut);
+        if (fin == std::string_view::npos) fin = texte.size();
+        ++numeroLigne;
+        analyserLigne(trim(texte.substr(debut, fin - debut)));
+        debut = fin + 1;
+    }
+}
+
+void Parseur::AnalyseFlux::analyserLigne(std::string_view ligne) {
+    if (ligne.empty() || ligne[0] == '#') return;  // Lignes vides ou commentaires
+    if (format == Format::INCONNU) {
+        bool enTete = ligne.size() > 1 && ligne[0] == 'p' && std::isspace(static_cast<unsigned char>(ligne[1]));
+        format = enTete ? Format::NUMERIQUE : Format::APX;
+    }
+    if (format == Format::NUMERIQUE) {
+        analyserLigneNumerique(ligne);
+        return;
+    }
+    // Mêmes contrôles et messages que l'analyse par blocs
+    try {
+        if (ligne.substr(0, 4) == "arg(") {
+            ajouterArgument(parserLigneArgument(ligne));
+        } else if (ligne.substr(0, 4) == "att(") {
+            auto [source, cible] = parserLigneAttaque(ligne);
+            int u = systeme.trouverId(source);
+            int v = systeme.trouverId(cible);
+            if (u == -1 || v == -1) signalerErreur("Attaque invalide (arguments inexistants) : " + std::string(ligne));
+            else ajouterAttaque(u, v, ligne);
+        } else {
+            signalerErreur("Format invalide (doit commencer par 'arg(' ou 'att(') : " + std::string(ligne));
+        }
+    } catch (const ErreurParsing& e) {
+        ligneErreur = numeroLigne;
+        messageErreur = e.what();
+    }
+}
+
+void Parseur::AnalyseFlux::analyserLigneNumerique(std::string_view ligne) {
+    std::string_view reste = ligne;
+    if (ligne[0] == 'p') {
+        // En-tête : les arguments 1 à N sont déclarés d'un coup
+        reste = trim(ligne.substr(1));
+        size_t n = 0;
+        bool valide = reste.substr(0, 2) == "af";
+        if (valide) {
+            reste.remove_prefix(2);
+            valide = lireEntier(reste, n) && trim(reste).empty();
+        }
+        if (!valide || n > static_cast<size_t>(std::numeric_limits<int>::max())) {
+            signalerErreur("En-tête invalide (attendu 'p af N') : " + std::string(ligne));
+        } else if (systeme.getNbArguments() > 0 || !attaques.empty()) {
+            signalerErreur("En-tête répété : " + std::string(ligne));
+        } else {
+            systeme.reserver(n, n * std::to_string(n).size());
+            nbCibles.reserve(n);
+            nbAttaquants.reserve(n);
+            for (size_t i = 1; i <= n; ++i) ajouterArgument(std::to_string(i));
+        }
+        return;
+    }
+    size_t source = 0, cible = 0;
+    if (!lireEntier(reste, source) || !lireEntier(reste, cible) || !trim(reste).empty()) {
+        signalerErreur("Format invalide (attendu 'source cible') : " + std::string(ligne));
+        return;
+    }
+    size_t n = systeme.getNbArguments();
+    if (source < 1 || source > n || cible < 1 || cible > n) {
+        signalerErreur("Attaque invalide (arguments inexistants) : " + std::string(ligne));
+        return;
+    }
+    ajouterAttaque(static_cast<int>(source - 1), static_cast<int>(cible - 1), ligne);
+}
+
+void Parseur::AnalyseFlux::ajouterArgument(std::string_view nom) {
+    if (!systeme.ajouterArgument(nom)) return;  // Les redéclarations sont ignorées
+    nbCibles.push_back(0);
+    nbAttaquants.push_back(0);
+}
+
+void Parseur::AnalyseFlux::ajouterAttaque(int source, int cible, std::string_view ligne) {
+    // Une ligne valide a la longueur de sa forme canonique si elle ne contient ni espace superflu ni zéro de tête
+    size_t longueurCanonique = format == Format::NUMERIQUE
+        ? nbChiffres(static_cast<size_t>(source) + 1) + nbChiffres(static_cast<size_t>(cible) + 1) + 1
+        : systeme.getNom(source).size() + systeme.getNom(cible).size() + 7;
+    bool canonique = ligne.size() == longueurCanonique &&
+                     (format != Format::NUMERIQUE || ligne.find_first_of("\t\v\f\r") == std::string_view::npos);
+    if (!canonique) textesAtypiques.emplace_back(attaques.size(), std::string(ligne));
+    attaques.emplace_back(source, cible);
+    lignes.push_back(numeroLigne);
+    ++nbCibles[source];
+    ++nbAttaquants[cible];
+}
+
+std::string Parseur::AnalyseFlux::texteAttaque(size_t indice) const {
+    auto it = std::lower_bound(textesAtypiques.begin(), textesAtypiques.end(), indice,
+                               [](const auto& texte, size_t i) { return texte.first < i; });
+    if (it != textesAtypiques.end() && it->first == indice) return it->second;
+    auto [source, cible] = attaques[indice];
+    return format == Format::NUMERIQUE
+        ? std::to_string(source + 1) + " " + std::to_string(cible + 1)
+        : "att(" + std::string(systeme.getNom(source)) + "," + std::string(systeme.getNom(cible)) + ").";
+}
+
+void Parseur::AnalyseFlux::signalerErreur(const std::string& message) {
+    ligneErreur = numeroLigne;
+    messageErreur = "Ligne " + std::to_string(numeroLigne) + " : " + message;
+}
+
+SystemeArgumentation Parseur::AnalyseFlux::finaliser(const std::string& nomSource) {
+    // Listes dimensionnées d'après les degrés comptés pendant la lecture, remplies dans l'ordre du flux
+    size_t n = systeme.getNbArguments();
+    std::vector<std::vector<int>> adjacence(n), parents(n);
+    for (size_t i = 0; i < n; ++i) {
+        adjacence[i].reserve(nbCibles[i]);
+        parents[i].reserve(nbAttaquants[i]);
+    }
+    for (const auto& [source, cible] : attaques) {
+        adjacence[source].push_back(cible);
+        parents[cible].push_back(source);
+    }
+
+    // Doublons : une cible vue deux fois dans la liste d'une même source (marquage en temps linéaire)
+    std::vector<int> marque(n, -1);
+    bool doublon = false;
+    for (size_t u = 0; u < n && !doublon; ++u) {
+        for (int v : adjacence[u]) {
+            doublon |= marque[v] == static_cast<int>(u);
+            marque[v] = static_cast<int>(u);
+        }
+    }
+    // Cas rare : on retrouve la ligne de la première répétition, rejetée comme par l'analyse par blocs
+    if (doublon) {
+        std::vector<size_t> ordre(attaques.size());
+        for (size_t i = 0; i < ordre.size(); ++i) ordre[i] = i;
+        std::sort(ordre.begin(), ordre.end(), [&](size_t a, size_t b) {
+            return attaques[a] != attaques[b] ? attaques[a] < attaques[b] : a < b;
+        });
+        size_t premier = AUCUNE_LIGNE;
+        for (size_t k = 1; k < ordre.size(); ++k) {
+            if (attaques[ordre[k]] == attaques[ordre[k - 1]]) premier = std::min(premier, ordre[k]);
+        }
+        if (ligneErreur == 0 || lignes[premier] < ligneErreur) {
+            ligneErreur = lignes[premier];
+            messageErreur = "Ligne " + std::to_string(ligneErreur) + " : Attaque invalide (arguments inexistants) : "
+                            + texteAttaque(premier);
+        }
+    }
+    if (ligneErreur != 0) {
+        throw ErreurParsing("Erreur de parsing dans '" + nomSource + "' ligne " + std::to_string(ligneErreur) +
+            " : " + messageErreur);
+    }
+
+    systeme.remplacerAttaques(std::move(adjacence), std::move(parents));
+    if (n == 0) throw ErreurParsing("Le fichier '" + nomSource + "' ne contient aucun argument valide");
+    return std::move(systeme);
+}
+
+// Analyse séquentielle d'un bloc, ligne par ligne
+void Parseur::analyserBloc(std::string_view bloc, BlocAnalyse& resultat) {
+    size_t debut = 0;
+    size_t numeroLigne = 0;  // Pour indiquer l'emplacement exact de l'erreur
+    while (debut < bloc.size()) {
+        size_t fin = bloc.find('\n', debut);
+        if (fin == std::string_view::npos) fin = bloc.size();
+        std::string_view ligne = trim(bloc.substr(debut, fin - debut));  // Supprimer les espaces blancs
+        debut = fin + 1;
         ++numeroLigne;
-        ligne = trim(ligne);  // Supprimer les espaces blancs en début et fin
 
         if (ligne.empty() || ligne[0] == '#') {  // Ignorer les lignes vides ou commentaires
             continue;
@@ -29,67 +652,63 @@ SystemeArgumentation Parseur::parserFichier(const std::string& cheminFichier) {
 
         try {
             if (ligne.substr(0, 4) == "arg(") {  // Vérifier si la ligne commence par arg(
-                std::string nomArg = parserLigneArgument(ligne);
-                (void)systeme.ajouterArgument(nomArg);  // Ajouter l'argument au système (retour booléen est ignoré)
-
+                resultat.arguments.push_back({parserLigneArgument(ligne), numeroLigne});
             }
             else if (ligne.substr(0, 4) == "att(") {  // Vérifier si la ligne commence par att(
                 auto [source, cible] = parserLigneAttaque(ligne);
-                bool ajoutReussi = systeme.ajouterAttaque(source, cible);  // Ajouter l'attaque au système
-                if (!ajoutReussi) {  // Si l'ajout échoue, c'est qu'un argument n'existe pas
-                    throw ErreurParsing("Ligne " + std::to_string(numeroLigne) +
-                        " : Attaque invalide (arguments inexistants) : " + ligne);
-                }
+                // L'existence des arguments est vérifiée lors de la fusion des blocs
+                resultat.attaques.push_back({source, cible, numeroLigne});
             }
             else {
-                throw ErreurParsing("Ligne " + std::to_string(numeroLigne) +
-                    " : Format invalide (doit commencer par 'arg(' ou 'att(') : " + ligne);
+                resultat.ligneErreur = numeroLigne;
+                resultat.messageErreur = "Format invalide (doit commencer par 'arg(' ou 'att(') : " + std::string(ligne);
+                resultat.prefixerLigne = true;
+                break;  // Le compteur de lignes est complété après la boucle
             }
         }
         catch (const ErreurParsing& e) {
-            fichier.close();  // Fermer le fichier en cas d'erreur
-            throw ErreurParsing("Erreur de parsing dans '" + cheminFichier +
-                "' ligne " + std::to_string(numeroLigne) + " : " + e.what());
+            resultat.ligneErreur = numeroLigne;  // On s'arrête à la première erreur du bloc
+            resultat.messageErreur = e.what();
+            break;
         }
     }
-
-    fichier.close();
-
-    if (systeme.getNbArguments() == 0) {  // Vérifier qu'on a au moins un argument
-        throw ErreurParsing("Le fichier '" + cheminFichier +"' ne contient aucun argument valide");
+    // Les lignes restantes après une erreur sont seulement comptées, pour numéroter les blocs suivants
+    if (debut < bloc.size()) {
+        std::string_view reste = bloc.substr(debut);
+        numeroLigne += std::count(reste.begin(), reste.end(), '\n') + (reste.back() != '\n' ? 1 : 0);
     }
-    return systeme;
+    resultat.nbLignes = numeroLigne;
 }
 
 // Analyse une ligne déclarant un argument via arg(x). et extrait le nom x
-std::string Parseur::parserLigneArgument(const std::string& ligne) {
+std::string_view Parseur::parserLigneArgument(std::string_view ligne) {
     // Vérifications sur la structure attendue
-    if (ligne.length() < 7) throw ErreurParsing("Ligne trop courte : " + ligne);
+    if (ligne.length() < 7) throw ErreurParsing("Ligne trop courte : " + std::string(ligne));
     if (ligne.substr(0, 4) != "arg(") throw ErreurParsing("Doit commencer par 'arg('");
     if (ligne.substr(ligne.length() - 2) != ").") throw ErreurParsing("Doit finir par ').'");
 
-    std::string nom = ligne.substr(4, ligne.length() - 6);  // Extrait la sous-chaîne entre parenthèses
+    std::string_view nom = ligne.substr(4, ligne.length() - 6);  // Extrait la sous-chaîne entre parenthèses
 
-    if (nom.empty()) throw ErreurParsing("Nom d'argument vide : " + ligne);
-    if (!estNomValide(nom)) throw ErreurParsing("Nom d'argument invalide : " + nom);
+    if (nom.empty()) throw ErreurParsing("Nom d'argument vide : " + std::string(ligne));
+    if (!estNomValide(nom)) throw ErreurParsing("Nom d'argument invalide : " + std::string(nom));
 
     return nom;
 }
 
 // Analyse une ligne déclarant une attaque att(x,y). et extrait la paire {x, y}
-std::pair<std::string, std::string> Parseur::parserLigneAttaque(const std::string& ligne) {
+std::pair<std::string_view, std::string_view> Parseur::parserLigneAttaque(std::string_view ligne) {
     // Même logique que ci-dessus
-    if (ligne.length() < 9) throw ErreurParsing("Ligne trop courte : " + ligne);
+    if (ligne.length() < 9) throw ErreurParsing("Ligne trop courte : " + std::string(ligne));
     if (ligne.substr(0, 4) != "att(") throw ErreurParsing("Doit commencer par 'att('");
     if (ligne.substr(ligne.length() - 2) != ").") throw ErreurParsing("Doit finir par ').'");
 
-    std::string contenu = ligne.substr(4, ligne.length() - 6);  // Extrait la sous-chaîne entre parenthèses
+    std::string_view contenu = ligne.substr(4, ligne.length() - 6);  // Extrait la sous-chaîne entre parenthèses
 
     size_t posVirgule = contenu.find(',');  // Retourne la position de la première occurrence
-    if (posVirgule == std::string::npos) throw ErreurParsing("Virgule manquante : " + ligne);
+    if (posVirgule == std::string_view::npos) throw ErreurParsing("Virgule manquante : " + std::string(ligne));
 
-    std::string source = trim(contenu.substr(0, posVirgule));  // Supprimer les espaces éventuels
-    std::string cible = trim(contenu.substr(posVirgule + 1));
+    std::string_view source = trim(contenu.substr(0, posVirgule));  // Supprimer les espaces éventuels
+    std::string_view cible = trim(contenu.substr(posVirgule + 1));
 
     if (source.empty() || cible.empty()) throw ErreurParsing("Source ou cible vide");
     if (!estNomValide(source) || !estNomValide(cible)) throw ErreurParsing("Noms invalides dans l'attaque");
@@ -98,7 +717,7 @@ std::pair<std::string, std::string> Parseur::parserLigneAttaque(const std::strin
 }
 
 // Vérifie si un nom d'argument est valide (lettres, chiffres, underscore, pas arg ni att)
-bool Parseur::estNomValide(const std::string& nom) {
+bool Parseur::estNomValide(std::string_view nom) {
     if (nom.empty()) return false;
     if (nom == "arg" || nom == "att") return false;  // Mots réservés
 
@@ -109,20 +728,15 @@ bool Parseur::estNomValide(const std::string& nom) {
 }
 
 // Supprime les espaces en début et fin de chaîne
-std::string Parseur::trim(const std::string& str) {
-    if (str.empty()) return str;
-
+std::string_view Parseur::trim(std::string_view str) {
     // Recherche du premier caractère depuis le début
-    auto debut = std::find_if(str.begin(), str.end(), [](unsigned char c) {
-        return !std::isspace(c);
-    });
-
-    if (debut == str.end()) return ""; // Chaîne vide ou uniquement des espaces
+    size_t debut = 0;
+    while (debut < str.size() && std::isspace(static_cast<unsigned char>(str[debut]))) ++debut;
+    if (debut == str.size()) return {}; // Chaîne vide ou uniquement des espaces
 
-    // Recherche du premier caractère depuis la fin (reverse iterator)
-    auto fin = std::find_if(str.rbegin(), str.rend(), [](unsigned char c) {
-        return !std::isspace(c);
-    }).base(); // .base() reconvertit l'itérateur inverse en itérateur normal pour le constructeur de string
+    // Recherche du premier caractère depuis la fin
+    size_t fin = str.size();
+    while (fin > debut && std::isspace(static_cast<unsigned char>(str[fin - 1]))) --fin;
 
-    return {debut, fin};
+    return str.substr(debut, fin - debut);
 }
@@ -0,0 +1,214 @@
+/* RechercheLocale.cpp
+ * Marche aléatoire sur les labellings IN/OUT : compteurs d'attaquants IN tenus à jour à chaque bascule, liste des
+ * arguments en violation, choix de la bascule par nombre de cassures avec bruit, et redémarrages. */
+
+#include "RechercheLocale.hpp"
+#include "Semantiques.hpp"
+#include "Budget.hpp"
+#include <algorithm>  // std::max, std::min, std::shuffle
+#include <numeric>  // std::iota
+#include <random>  // std::mt19937_64
+#include <vector>  // std::vector
+
+
+namespace {
+    using std::vector;
+    using Utilitaires::EnsembleIds;
+
+    RechercheLocale::Parametres reglages;
+
+    // Labelling courant et contraintes violées : un argument est en violation s'il est IN avec un attaquant IN
+    // (conflit) ou OUT sans attaquant IN (non défait). Le labelling est une extension stable quand il n'y en a plus
+    // L'argument imposé, s'il y en a un, reste IN et n'est jamais basculé ; l'argument exclu reste OUT
+    class Marche {
+    private:
+        const vector<vector<int>>& cibles_;
+        const vector<vector<int>>& attaquants_;
+        size_t n_;
+        int impose_;  // Argument imposé IN, ou -1
+        int exclu_;  // Argument imposé OUT, ou -1
+        vector<char> dedans_;  // Statut IN de chaque argument
+        vector<int> attaquantsIn_;  // Nombre d'attaquants IN de chaque argument (lui-même compris s'il s'auto-attaque)
+        vector<int> violes_;  // Arguments en violation, dans un ordre quelconque
+        vector<int> position_;  // Position dans violes_, ou -1
+        vector<char> autoAttaque_, bloque_;
+        vector<int> ordre_, candidats_, meilleurs_;
+        std::mt19937_64 alea_;
+
+        bool enViolation(int v) const {
+            return dedans_[v] ? attaquantsIn_[v] > 0 : attaquantsIn_[v] == 0;
+        }
+
+        // Met la liste des violations à jour pour v, en O(1)
+        void actualiser(int v) {
+            bool viole = enViolation(v);
+            if (viole && position_[v] < 0) {
+                position_[v] = static_cast<int>(violes_.size());
+                violes_.push_back(v);
+            } else if (!viole && position_[v] >= 0) {
+                int dernier = violes_.back();
+                violes_[position_[v]] = dernier;
+                position_[dernier] = position_[v];
+                violes_.pop_back();
+                position_[v] = -1;
+            }
+        }
+
+        // Nombre d'arguments respectés qui passeraient en violation si x basculait : seuls x et ses cibles changent
+        int cassures(int x) const {
+            int total = 0;
+            if (!dedans_[x]) {  // OUT -> IN : x en conflit s'il est attaqué, ses cibles IN non attaquées aussi
+                if (attaquantsIn_[x] > 0) ++total;
+                for (int c : cibles_[x]) if (c != x && dedans_[c] && attaquantsIn_[c] == 0) ++total;
+            } else {  // IN -> OUT : x non défait s'il n'est pas attaqué, ses cibles OUT dont il était le seul attaquant IN
+                if (attaquantsIn_[x] == 0) ++total;
+                for (int c : cibles_[x]) if (c != x && !dedans_[c] && attaquantsIn_[c] == 1) ++total;
+            }
+            return total;
+        }
+
+        void basculer(int x) {
+            dedans_[x] = !dedans_[x];
+            int delta = dedans_[x] ? 1 : -1;
+            for (int c : cibles_[x]) {
+                attaquantsIn_[c] += delta;
+                actualiser(c);
+            }
+            actualiser(x);
+        }
+
+        size_t tirer(size_t borne) {
+            return static_cast<size_t>(alea_() % borne);
+        }
+
+        // Une étape : une violation tirée au hasard, les arguments dont la bascule la corrige, et parmi eux celui qui
+        // ne casse rien, sinon un candidat au hasard avec la probabilité du bruit, sinon celui qui casse le moins
+        void etape(double bruit) {
+            int v = violes_[tirer(violes_.size())];
+            candidats_.clear();
+            if (!dedans_[v]) {  // Non défait : v ou l'un de ses attaquants, tous OUT comme lui, doit passer IN
+                if (v != exclu_) candidats_.push_back(v);
+                for (int p : attaquants_[v]) if (p != v && p != exclu_) candidats_.push_back(p);
+            } else {  // Conflit : une attaque p -> v entre arguments IN, tirée au hasard, perd l'une de ses extrémités
+                int p = -1;
+                size_t vus = 0;
+                for (int a : attaquants_[v]) if (dedans_[a] && tirer(++vus) == 0) p = a;
+                if (v != impose_) candidats_.push_back(v);
+                if (p != v && p != impose_) candidats_.push_back(p);
+            }
+            if (candidats_.empty()) return;
+
+            int minimum = -1;
+            meilleurs_.clear();
+            for (int x : candidats_) {
+                int c = cassures(x);
+                if (minimum < 0 || c < minimum) {
+                    minimum = c;
+                    meilleurs_.clear();
+                }
+                if (c == minimum) meilleurs_.push_back(x);
+            }
+            bool auHasard = minimum > 0 && static_cast<double>(alea_() >> 11) * 0x1.0p-53 < bruit;
+            basculer(auHasard ? candidats_[tirer(candidats_.size())] : meilleurs_[tirer(meilleurs_.size())]);
+        }
+
+        // Passe v IN et interdit ses voisins à la construction gloutonne
+        void poser(int v) {
+            dedans_[v] = 1;
+            for (int c : cibles_[v]) bloque_[c] = 1;
+            for (int p : attaquants_[v]) bloque_[p] = 1;
+        }
+
+    public:
+        Marche(const SystemeArgumentation& sa, int impose, int exclu, uint64_t graine)
+            : cibles_(sa.getAdjacence()), attaquants_(sa.getParents()), n_(sa.getNbArguments()), impose_(impose),
+              exclu_(exclu), autoAttaque_(n_, 0), ordre_(n_), alea_(graine) {
+            for (size_t v = 0; v < n_; ++v) {
+                for (int c : cibles_[v]) if (c == static_cast<int>(v)) autoAttaque_[v] = 1;
+            }
+            std::iota(ordre_.begin(), ordre_.end(), 0);
+        }
+
+        // Vrai si l'argument imposé s'auto-attaque (aucune extension ne peut le contenir) ou est aussi exclu
+        bool impossible() const {
+            return impose_ >= 0 && (autoAttaque_[impose_] || impose_ == exclu_);
+        }
+
+        // Nouveau point de départ : ensemble sans conflit maximal construit dans un ordre aléatoire, qui ne laisse
+        // en violation que des arguments OUT non défaits
+        void initialiser() {
+            dedans_.assign(n_, 0);
+            bloque_.assign(n_, 0);
+            if (impose_ >= 0) poser(impose_);
+            if (exclu_ >= 0) bloque_[exclu_] = 1;
+            std::shuffle(ordre_.begin(), ordre_.end(), alea_);
+            for (int v : ordre_) if (!bloque_[v] && !autoAttaque_[v] && !dedans_[v]) poser(v);
+
+            attaquantsIn_.assign(n_, 0);
+            for (size_t v = 0; v < n_; ++v) {
+                if (dedans_[v]) for (int c : cibles_[v]) ++attaquantsIn_[c];
+            }
+            violes_.clear();
+            position_.assign(n_, -1);
+            for (size_t v = 0; v < n_; ++v) actualiser(static_cast<int>(v));
+        }
+
+        // Au plus limite étapes depuis le labelling courant, comptées dans effectuees
+        // Retourne vrai si plus aucun argument n'est en violation
+        bool marcher(uint64_t limite, double bruit, uint64_t& effectuees) {
+            effectuees = 0;
+            while (!violes_.empty() && effectuees < limite) {
+                Budget::verifier();
+                etape(bruit);
+                ++effectuees;
+            }
+            return violes_.empty();
+        }
+
+        // Arguments IN du labelling courant, triés
+        EnsembleIds extension() const {
+            EnsembleIds S;
+            for (size_t v = 0; v < n_; ++v) if (dedans_[v]) S.push_back(static_cast<int>(v));
+            return S;
+        }
+    };
+}
+
+
+namespace RechercheLocale {
+
+void configurer(const Parametres& parametres) {
+    reglages = parametres;
+}
+
+const Parametres& parametres() {
+    return reglages;
+}
+
+std::optional<EnsembleIds> chercherStable(const SystemeArgumentation& sa, int argument, int exclu) {
+    uint64_t budget = exclu >= 0 ? std::min(reglages.bascules, reglages.basculesContreExemple) : reglages.bascules;
+    if (budget == 0) return std::nullopt;
+    uint64_t n = sa.getNbArguments();
+    uint64_t parEssai = reglages.basculesParEssai > 0 ? reglages.basculesParEssai
+                                                      : std::max<uint64_t>(1000000, 100 * n);
+    // Chaque requête a sa propre suite aléatoire, reproductible d'un lancement à l'autre
+    uint64_t graine = reglages.graine * 0x9E3779B97F4A7C15ull + static_cast<uint64_t>(argument + 1)
+                      + (static_cast<uint64_t>(exclu + 1) << 32);
+    Marche marche(sa, argument, exclu, graine);
+    if (marche.impossible()) return std::nullopt;
+
+    for (uint64_t restantes = budget; restantes > 0;) {
+        marche.initialiser();
+        uint64_t effectuees = 0;
+        if (marche.marcher(std::min(parEssai, restantes), reglages.bruit, effectuees)) {
+            // Contrôle indépendant des compteurs : un échec laisse simplement la main au moteur complet
+            EnsembleIds S = marche.extension();
+            if (!Semantiques::verifierStable(S, sa)) return std::nullopt;
+            return S;
+        }
+        restantes -= std::min(restantes, std::max<uint64_t>(effectuees, 1));
+    }
+    return std::nullopt;
+}
+
+}
@@ -0,0 +1,124 @@
+/* Reordonnancement.cpp
+ * Calcul des ordres de renumérotation (Cuthill-McKee inverse, composantes fortement connexes) et application. */
+
+#include "Reordonnancement.hpp"
+#include "ClassesGraphe.hpp"
+#include <algorithm>  // std::sort, std::stable_sort, std::reverse
+#include <numeric>  // std::iota
+#include <utility>  // std::pair
+
+
+namespace {
+    using std::vector;
+
+    // Ordre de Cuthill-McKee inverse : parcours en largeur du graphe non orienté, chaque composante partant d'un
+    // argument de degré minimal et les voisins étant visités par degré croissant, puis inversion de l'ordre obtenu
+    vector<int> ordreRcm(const SystemeArgumentation& sa) {
+        const auto& adjacence = sa.getAdjacence();
+        const auto& parents = sa.getParents();
+        size_t n = sa.getNbArguments();
+        vector<size_t> degre(n);
+        for (size_t i = 0; i < n; ++i) degre[i] = adjacence[i].size() + parents[i].size();
+        vector<int> parDegre(n);
+        std::iota(parDegre.begin(), parDegre.end(), 0);
+        std::stable_sort(parDegre.begin(), parDegre.end(), [&](int a, int b) { return degre[a] < degre[b]; });
+
+        vector<int> ordre;
+        ordre.reserve(n);
+        vector<bool> vu(n, false);
+        vector<int> voisins;
+        for (int depart : parDegre) {
+            if (vu[depart]) continue;
+            vu[depart] = true;
+            size_t tete = ordre.size();
+            ordre.push_back(depart);
+            for (; tete < ordre.size(); ++tete) {
+                int u = ordre[tete];
+                voisins.clear();
+                for (const auto* liste : {&adjacence[u], &parents[u]}) {
+                    for (int v : *liste) if (!vu[v]) { vu[v] = true; voisins.push_back(v); }
+                }
+                std::sort(voisins.begin(), voisins.end(), [&](int a, int b) {
+                    return degre[a] != degre[b] ? degre[a] < degre[b] : a < b;
+                });
+                ordre.insert(ordre.end(), voisins.begin(), voisins.end());
+            }
+        }
+        std::reverse(ordre.begin(), ordre.end());
+        return ordre;
+    }
+
+    // Composantes fortement connexes dans l'ordre topologique, chacune parcourue en largeur par ses arcs internes :
+    // la recherche décide les attaquants avant leurs cibles et garde chaque cycle sur des identifiants contigus
+    vector<int> ordreTopologique(const SystemeArgumentation& sa) {
+        const auto& adjacence = sa.getAdjacence();
+        const auto& parents = sa.getParents();
+        size_t n = sa.getNbArguments();
+        int nbComposantes = 0;
+        vector<int> composante = ClassesGraphe::composantesFortes(adjacence, nbComposantes);
+
+        // Tarjan numérote les composantes en ordre topologique inverse : on les prend par numéro décroissant
+        vector<vector<int>> membres(nbComposantes);
+        for (size_t i = 0; i < n; ++i) membres[composante[i]].push_back(static_cast<int>(i));
+
+        vector<int> ordre;
+        ordre.reserve(n);
+        vector<bool> vu(n, false);
+        for (int c = nbComposantes - 1; c >= 0; --c) {
+            for (int depart : membres[c]) {
+                if (vu[depart]) continue;
+                vu[depart] = true;
+                size_t tete = ordre.size();
+                ordre.push_back(depart);
+                for (; tete < ordre.size(); ++tete) {
+                    int u = ordre[tete];
+                    for (const auto* liste : {&adjacence[u], &parents[u]}) {
+                        for (int v : *liste) {
+                            if (!vu[v] && composante[v] == c) { vu[v] = true; ordre.push_back(v); }
+                        }
+                    }
+                }
+            }
+        }
+        return ordre;
+    }
+}
+
+
+namespace Reordonnancement {
+
+bool lireOrdre(const std::string& nom, OrdreArguments& ordre) {
+    static const std::pair<const char*, OrdreArguments> noms[] = {
+        {"declaration", OrdreArguments::DECLARATION}, {"rcm", OrdreArguments::RCM},
+        {"scc", OrdreArguments::TOPOLOGIQUE}
+    };
+    for (const auto& [nomConnu, valeur] : noms) {
+        if (nom == nomConnu) {
+            ordre = valeur;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<int> calculerPermutation(const SystemeArgumentation& sa, OrdreArguments ordre) {
+    size_t n = sa.getNbArguments();
+    std::vector<int> sequence;  // sequence[k] : argument qui reçoit l'identifiant k
+    switch (ordre) {
+        case OrdreArguments::RCM: sequence = ordreRcm(sa); break;
+        case OrdreArguments::TOPOLOGIQUE: sequence = ordreTopologique(sa); break;
+        default:
+            sequence.resize(n);
+            std::iota(sequence.begin(), sequence.end(), 0);
+    }
+    std::vector<int> nouvelId(n);
+    for (size_t k = 0; k < n; ++k) nouvelId[sequence[k]] = static_cast<int>(k);
+    return nouvelId;
+}
+
+void reordonner(SystemeArgumentation& sa, OrdreArguments ordre) {
+    if (ordre == OrdreArguments::DECLARATION) return;
+    sa.renumeroter(calculerPermutation(sa, ordre));
+}
+
+}
@@ -2,8 +2,10 @@
  * Implémentation des algorithmes de résolution utilisant une approche par labelling et backtracking. */
 
 #include "Semantiques.hpp"
-#include <algorithm>  // std::sort, std::binary_search
+#include "Budget.hpp"
+#include <algorithm>  // std::sort, std::binary_search, std::upper_bound
 #include <functional>
+#include <queue>  // std::queue
 
 // Fonctions internes encapsulées dans un namespace anonyme pour ne pas polluer l'espace global
 namespace {
@@ -29,22 +31,60 @@ namespace {
         return estAdmissible(S_prime, sa);
     }
 
-    // Étend un ensemble admissible de manière gloutonne pour en faire une extension maximale
-    void etendreEnMaximal(EnsembleIds& S, const SystemeArgumentation& sa) {
-        size_t nbArgs = sa.getNbArguments();
-        for (size_t i = 0; i < nbArgs; ++i) {
-            // On tente d'ajouter l'argument i s'il est compatible
-            // estExtensibleAvec vérifie déjà la présence, pas besoin de revérifié
-            if (estExtensibleAvec(S, static_cast<int>(i), sa)) {
-                S.push_back(static_cast<int>(i));
-                std::sort(S.begin(), S.end()); // On re-trie après insertion
+    // Marque les arguments qui s'attaquent eux-mêmes
+    vector<bool> calculerAutoAttaques(const vector<vector<int>>& adjacence) {
+        vector<bool> autoAttaque(adjacence.size(), false);
+        for (size_t i = 0; i < adjacence.size(); ++i) {
+            for (int c : adjacence[i]) if (c == static_cast<int>(i)) autoAttaque[i] = true;
+        }
+        return autoAttaque;
+    }
+
+    // Sous-graphe des ancêtres d'un argument, renuméroté dans un espace d'identifiants compact
+    // L'argument de départ a l'identifiant local 0
+    struct Cone {
+        vector<int> versGlobal;  // versGlobal[idLocal] : identifiant dans le système complet
+        vector<vector<int>> parents;  // Attaquants, en identifiants locaux
+        vector<vector<int>> adjacence;  // Cibles appartenant au cône, en identifiants locaux
+    };
+
+    // Parcours en largeur inverse depuis argId via les parents : seuls les ancêtres influencent l'admissibilité
+    Cone construireCone(int argId, const SystemeArgumentation& sa) {
+        const auto& parents = sa.getParents();
+        vector<int> versLocal(sa.getNbArguments(), -1);
+        Cone cone;
+        queue<int> file;
+        versLocal[argId] = 0;
+        cone.versGlobal.push_back(argId);
+        file.push(argId);
+        while (!file.empty()) {
+            int courant = file.front();
+            file.pop();
+            for (int p : parents[courant]) {
+                if (versLocal[p] != -1) continue;
+                versLocal[p] = static_cast<int>(cone.versGlobal.size());
+                cone.versGlobal.push_back(p);
+                file.push(p);
+            }
+        }
+
+        // Renumérotation des arcs internes au cône (tout attaquant d'un membre est membre)
+        size_t taille = cone.versGlobal.size();
+        cone.parents.resize(taille);
+        cone.adjacence.resize(taille);
+        for (size_t local = 0; local < taille; ++local) {
+            for (int p : parents[cone.versGlobal[local]]) {
+                cone.parents[local].push_back(versLocal[p]);
+                cone.adjacence[versLocal[p]].push_back(static_cast<int>(local));
             }
         }
+        return cone;
     }
 
     // Cherche à construire un ensemble admissible valide respectant les contraintes labels
     bool trouverAdmissibleRecursive(vector<Label>& labels, const vector<vector<int>>& parents,
-        const vector<vector<int>>& adjacence, const SystemeArgumentation& sa) {
+        const vector<vector<int>>& adjacence, const vector<bool>& autoAttaque) {
+        Budget::verifier();  // Point de contrôle du temps et de la mémoire
 
         int argAProbleme = -1;
 
@@ -80,7 +120,7 @@ namespace {
                  for (int defenseur : defenseursPotentiels) {
                      // Si le défenseur est déjà OUT ou s'auto-attaque, inutile de le choisir : élagage
                      if (labels[defenseur] == OUT) continue;
-                     if (sa.attaqueExiste(defenseur, defenseur)) continue;
+                     if (autoAttaque[defenseur]) continue;
 
                      vector<Label> backup = labels;
                      labels[defenseur] = IN;
@@ -93,7 +133,7 @@ namespace {
                      }
                      // Récursion
                      if (!conflitImmediat) {
-                         if (trouverAdmissibleRecursive(labels, parents, adjacence, sa)) return true;
+                         if (trouverAdmissibleRecursive(labels, parents, adjacence, autoAttaque)) return true;
                      }
                      labels = backup;
                  }
@@ -105,9 +145,47 @@ namespace {
     }
 
 
+    // Arguments IN d'un labelling, dans l'ordre croissant
+    EnsembleIds argumentsIn(const vector<Label>& labels) {
+        EnsembleIds S;
+        for (size_t i = 0; i < labels.size(); ++i) if (labels[i] == IN) S.push_back(static_cast<int>(i));
+        return S;
+    }
+
+    // Étend un ensemble admissible en une extension préférée : chaque argument extérieur est forcé IN avec S et la
+    // recherche d'admissible dit s'il existe un sur-ensemble admissible qui le contient (ce qui capture aussi les
+    // arguments qui ne peuvent entrer qu'accompagnés). Un argument refusé le reste pour tout sur-ensemble, une passe suffit
+    void etendreEnMaximal(EnsembleIds& S, const SystemeArgumentation& sa, const vector<bool>& autoAttaque) {
+        const auto& adjacence = sa.getAdjacence();
+        size_t nbArgs = sa.getNbArguments();
+        vector<bool> estDansS(nbArgs, false);
+        for (int id : S) estDansS[id] = true;
+
+        for (size_t x = 0; x < nbArgs; ++x) {
+            if (estDansS[x] || autoAttaque[x]) continue;
+            vector<Label> labels(nbArgs, UNDEC);
+            for (int id : S) labels[id] = IN;
+            labels[x] = IN;
+            bool conflit = false;
+            for (size_t i = 0; i < nbArgs && !conflit; ++i) {
+                if (labels[i] != IN) continue;
+                for (int c : adjacence[i]) {
+                    if (labels[c] == IN) { conflit = true; break; }
+                    labels[c] = OUT;
+                }
+            }
+            if (conflit) continue;
+            if (trouverAdmissibleRecursive(labels, sa.getParents(), adjacence, autoAttaque)) {
+                S = argumentsIn(labels);
+                for (int id : S) estDansS[id] = true;
+            }
+        }
+    }
+
     // Parcourt les arguments un par un pour construire une extension stable.
     bool trouverStableRecursive(vector<Label>& labels, int index, const SystemeArgumentation& sa,
         const vector<vector<int>>& parents) {
+        Budget::verifier();  // Point de contrôle du temps et de la mémoire
         size_t n = labels.size();
 
         // Cas de base : tous les arguments ont été traités
@@ -170,7 +248,8 @@ bool Semantiques::verifierStable(const EnsembleIds& S, const SystemeArgumentatio
     return attaqueToutExterieur(S, sa);
 }
 // Vérifie si S est une extension préférée
-bool Semantiques::verifierPreferee(const EnsembleIds& S, const SystemeArgumentation& sa) {
+bool Semantiques::verifierPreferee(const EnsembleIds& S, const SystemeArgumentation& sa,
+                                   std::optional<EnsembleIds>* temoin) {
     // 1 - S doit être un ensemble admissible
     if (!estAdmissible(S, sa)) return false;
 
@@ -182,9 +261,16 @@ bool Semantiques::verifierPreferee(const EnsembleIds& S, const SystemeArgumentat
     for (int id : S) estDansS[id] = true;
 
     for (size_t i = 0; i < nbArgs; ++i) {
+        Budget::verifier();
         if (!estDansS[i]) {
             // Si on peut étendre avec i, alors S n'est pas une extension préférée
             if (estExtensibleAvec(S, static_cast<int>(i), sa)) {
+                if (temoin) {
+                    EnsembleIds plusGrand = S;
+                    plusGrand.insert(std::upper_bound(plusGrand.begin(), plusGrand.end(), static_cast<int>(i)),
+                                     static_cast<int>(i));
+                    *temoin = plusGrand;
+                }
                 return false;
             }
         }
@@ -195,7 +281,7 @@ bool Semantiques::verifierPreferee(const EnsembleIds& S, const SystemeArgumentat
 
 // Decision Credulous DC
 // Acceptabilité crédule pour la sémantique stable
-bool Semantiques::credulousStable(int argId, const SystemeArgumentation& sa) {
+bool Semantiques::credulousStable(int argId, const SystemeArgumentation& sa, std::optional<EnsembleIds>* temoin) {
     size_t n = sa.getNbArguments();
     vector<Label> labels(n, UNDEC);
     // Initialisation : on force l'argument cible à IN
@@ -210,37 +296,47 @@ bool Semantiques::credulousStable(int argId, const SystemeArgumentation& sa) {
     for (int p : sa.getParents()[argId]) {
         if (p == argId) return false;
     }
-    return trouverStableRecursive(labels, 0, sa, sa.getParents());
+    if (!trouverStableRecursive(labels, 0, sa, sa.getParents())) return false;
+    if (temoin) *temoin = argumentsIn(labels);  // En cas de succès, labels contient l'extension trouvée
+    return true;
 }
 // Acceptabilité crédule pour la sémantique préférée
-bool Semantiques::credulousPreferred(int argId, const SystemeArgumentation& sa) {
+bool Semantiques::credulousPreferred(int argId, const SystemeArgumentation& sa, std::optional<EnsembleIds>* temoin) {
     // On cherche une extension admissible contenant argId
-    size_t n = sa.getNbArguments();
-    vector<Label> labels(n, UNDEC);
+    // Elle ne dépend que des ancêtres de argId : la recherche se fait dans ce cône, argId y a l'identifiant 0
+    Cone cone = construireCone(argId, sa);
+    vector<Label> labels(cone.versGlobal.size(), UNDEC);
 
     // 1 - Hypothèse : argId est IN
-    labels[argId] = IN;
+    labels[0] = IN;
     // 2 - Propagation aux cibles, elles deviennent OUT
-    const auto& cibles = sa.getAdjacence()[argId];
-    for (int c : cibles) {
-        if (c == argId) return false; // Auto-attaque
+    for (int c : cone.adjacence[0]) {
+        if (c == 0) return false; // Auto-attaque
         labels[c] = OUT;
     }
-    // 3 - Vérification : pas d'auto-attaque parentale
-    for (int p : sa.getParents()[argId]) {
-        if (p == argId) return false; // Auto-attaque
-    }
 
     // On ne force pas les attaquants à OUT ici : on laisse le solveur trouverAdmissibleRecursive
     // détecter qu'ils ne sont pas OUT et chercher des défenseurs
-    return trouverAdmissibleRecursive(labels, sa.getParents(), sa.getAdjacence(), sa);
+    if (!trouverAdmissibleRecursive(labels, cone.parents, cone.adjacence, calculerAutoAttaques(cone.adjacence))) {
+        return false;
+    }
+    if (temoin) {  // Un ensemble admissible du cône l'est aussi dans le système complet
+        EnsembleIds S;
+        for (int local : argumentsIn(labels)) S.push_back(cone.versGlobal[local]);
+        std::sort(S.begin(), S.end());
+        *temoin = S;
+    }
+    return true;
 }
 
 // Decision Skeptical DS
 // Acceptabilité sceptique pour la sémantique stable
-bool Semantiques::skepticalStable(int argId, const SystemeArgumentation& sa) {
-    // Il doit être au moins stable une fois
-    if (!credulousStable(argId, sa)) return false;
+bool Semantiques::skepticalStable(int argId, const SystemeArgumentation& sa, std::optional<EnsembleIds>* temoin) {
+    // Il doit être au moins stable une fois, sinon toute extension stable (s'il en existe) est un contre-exemple
+    if (!credulousStable(argId, sa)) {
+        if (temoin) existeStable(sa, temoin);
+        return false;
+    }
 
     // On cherche de contre-exemple : si on trouve une extension stable où argId n'est pas IN, alors return FALSE
     size_t n = sa.getNbArguments();
@@ -249,6 +345,7 @@ bool Semantiques::skepticalStable(int argId, const SystemeArgumentation& sa) {
     labels[argId] = OUT;
 
     if (trouverStableRecursive(labels, 0, sa, sa.getParents())) {
+        if (temoin) *temoin = argumentsIn(labels);
         return false; // Contre-exemple trouvé
     }
     // Si aucune extension stable ne peut contenir argId à OUT, alors il est dans toutes
@@ -256,9 +353,12 @@ bool Semantiques::skepticalStable(int argId, const SystemeArgumentation& sa) {
 }
 
 // Acceptabilité sceptique pour la sémantique préférée
-bool Semantiques::skepticalPreferred(int argId, const SystemeArgumentation& sa) {
-    // Il doit être au moins crédule une fois
-    if (!credulousPreferred(argId, sa)) return false;
+bool Semantiques::skepticalPreferred(int argId, const SystemeArgumentation& sa, std::optional<EnsembleIds>* temoin) {
+    // Il doit être au moins crédule une fois, sinon toute extension préférée est un contre-exemple
+    if (!credulousPreferred(argId, sa)) {
+        if (temoin) *temoin = extensionPreferee(sa);
+        return false;
+    }
 
     // On cherche un contre-exemple par exploration en essayant de construire une ext pr qui ne contient pas argId
     size_t n = sa.getNbArguments();
@@ -269,6 +369,8 @@ bool Semantiques::skepticalPreferred(int argId, const SystemeArgumentation& sa)
     // On lance le solveur pour trouver n'importe quel ensemble admissible qui respecte argId = OUT
     // On itère sur tous les autres arguments pour tenter de construire une extension sans argId
 
+    vector<bool> autoAttaque = calculerAutoAttaques(sa.getAdjacence());
+
     // Fonction interne pour tenter de trouver un contre-exemple depuis un point de départ
     auto chercherContreExemple = [&](int startNode) -> bool {
         if (startNode == argId) return false;
@@ -280,7 +382,7 @@ bool Semantiques::skepticalPreferred(int argId, const SystemeArgumentation& sa)
         for(int c : sa.getAdjacence()[startNode]) localLabels[c] = OUT;
         for(int p : sa.getParents()[startNode]) if(p == startNode) return false;
 
-        if (trouverAdmissibleRecursive(localLabels, sa.getParents(), sa.getAdjacence(), sa)) {
+        if (trouverAdmissibleRecursive(localLabels, sa.getParents(), sa.getAdjacence(), autoAttaque)) {
             // On a trouvé un ensemble admissible S ne contenant pas argId
             EnsembleIds S;
             for(size_t i=0; i<n; ++i) if(localLabels[i] == IN) S.push_back((int)i);
@@ -289,22 +391,27 @@ bool Semantiques::skepticalPreferred(int argId, const SystemeArgumentation& sa)
                 return false; // Faux positif rejeté
             }
             // On l'étend au maximum
-            etendreEnMaximal(S, sa);
+            etendreEnMaximal(S, sa, autoAttaque);
 
             // Vérification finale : est-ce que l'extension maximale contient argId
             // (Il est possible qu'en étendant S, on ait été obligé d'ajouter argId pour défendre le reste)
             bool contientArgId = false;
             for(int x : S) if(x == argId) { contientArgId = true; break; }
 
-            if (!contientArgId) return true; // C'est un contre-exemple valide
+            if (!contientArgId) {  // C'est un contre-exemple valide
+                if (temoin) *temoin = S;
+                return true;
+            }
         }
         return false;
     };
 
     // Test de l'ensemble vide (cas où argId n'est pas nécessaire)
-    EnsembleIds vide;
-    etendreEnMaximal(vide, sa);
-    if (!std::binary_search(vide.begin(), vide.end(), argId)) return false;
+    EnsembleIds vide = extensionPreferee(sa);
+    if (!std::binary_search(vide.begin(), vide.end(), argId)) {
+        if (temoin) *temoin = vide;
+        return false;
+    }
 
     // Exploration depuis chaque autre argument
     for (size_t i = 0; i < n; ++i) {
@@ -318,3 +425,60 @@ bool Semantiques::skepticalPreferred(int argId, const SystemeArgumentation& sa)
     // on déduit que argId est sceptiquement accepté
     return true;
 }
+
+// Existence d'une extension stable : recherche sans argument forcé
+bool Semantiques::existeStable(const SystemeArgumentation& sa, std::optional<EnsembleIds>* temoin) {
+    vector<Label> labels(sa.getNbArguments(), UNDEC);
+    if (!trouverStableRecursive(labels, 0, sa, sa.getParents())) return false;
+    if (temoin) *temoin = argumentsIn(labels);
+    return true;
+}
+
+// Extension préférée : l'ensemble vide est admissible, on l'étend au maximum
+EnsembleIds Semantiques::extensionPreferee(const SystemeArgumentation& sa) {
+    EnsembleIds S;
+    etendreEnMaximal(S, sa, calculerAutoAttaques(sa.getAdjacence()));
+    return S;
+}
+
+
+// Sémantique fondée GR
+// Un argument dont tous les attaquants sont OUT passe IN, ses cibles passent OUT : chaque arc est vu au plus deux fois
+std::vector<LabelFonde> Semantiques::labellingFonde(const SystemeArgumentation& sa) {
+    size_t n = sa.getNbArguments();
+    const auto& adjacence = sa.getAdjacence();
+    const auto& parents = sa.getParents();
+
+    vector<LabelFonde> labels(n, LabelFonde::UNDEC);
+    vector<size_t> attaquantsRestants(n);  // Nombre d'attaquants pas encore OUT
+    queue<int> aAccepter;
+    for (size_t i = 0; i < n; ++i) {
+        attaquantsRestants[i] = parents[i].size();
+        if (attaquantsRestants[i] == 0) aAccepter.push(static_cast<int>(i));
+    }
+
+    while (!aAccepter.empty()) {
+        int a = aAccepter.front();
+        aAccepter.pop();
+        labels[a] = LabelFonde::IN;
+        for (int b : adjacence[a]) {
+            if (labels[b] != LabelFonde::UNDEC) continue;
+            labels[b] = LabelFonde::OUT;
+            // b ne compte plus comme attaquant pour ses cibles
+            for (int c : adjacence[b]) {
+                if (labels[c] == LabelFonde::UNDEC && --attaquantsRestants[c] == 0) aAccepter.push(c);
+            }
+        }
+    }
+    return labels;
+}
+
+// Extension fondée : arguments IN du labelling fondé
+EnsembleIds Semantiques::extensionFondee(const SystemeArgumentation& sa) {
+    vector<LabelFonde> labels = labellingFonde(sa);
+    EnsembleIds S;
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (labels[i] == LabelFonde::IN) S.push_back(static_cast<int>(i));
+    }
+    return S;
+}
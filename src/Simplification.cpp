@@ -0,0 +1,157 @@
+/* Simplification.cpp
+ * Implémentation du prétraitement : réduction par l'extension fondée, noyau de la sémantique visée, fusion des clones. */
+
+#include "Simplification.hpp"
+#include "Semantiques.hpp"
+#include "CompteurMemoire.hpp"
+#include <algorithm>  // std::sort, std::binary_search
+#include <cstdint>  // uint64_t
+
+
+namespace Simplification {
+
+using std::vector;
+
+SystemeSimplifie simplifier(const SystemeArgumentation& sa, SemantiqueCible semantique) {
+    CompteurMemoire::PorteePhase phase(CompteurMemoire::Phase::PRETRAITEMENT);
+    size_t n = sa.getNbArguments();
+    const auto& adjacence = sa.getAdjacence();
+
+    SystemeSimplifie resultat;
+    StatistiquesSimplification& stats = resultat.statistiques;
+    stats.argumentsInitiaux = n;
+    for (const auto& cibles : adjacence) stats.attaquesInitiales += cibles.size();
+
+    // 1 - Réduction par l'extension fondée : ses arguments et ceux qu'elle attaque sont fixés
+    vector<LabelFonde> labels = Semantiques::labellingFonde(sa);
+    resultat.statuts.assign(n, StatutSimplifie::CONSERVE);
+    vector<bool> autoAttaque(n, false);
+    for (size_t i = 0; i < n; ++i) {
+        if (labels[i] == LabelFonde::IN) {
+            resultat.statuts[i] = StatutSimplifie::ACCEPTE;
+            ++stats.argumentsAcceptes;
+        } else if (labels[i] == LabelFonde::OUT) {
+            resultat.statuts[i] = StatutSimplifie::REJETE;
+            ++stats.argumentsRejetes;
+        }
+        for (int c : adjacence[i]) {
+            if (c == static_cast<int>(i)) autoAttaque[i] = true;
+        }
+    }
+
+    // Listes triées des attaques restantes pour tester les attaques inverses par recherche binaire
+    vector<vector<int>> restantes(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (resultat.statuts[i] != StatutSimplifie::CONSERVE) continue;
+        for (int c : adjacence[i]) {
+            if (resultat.statuts[c] == StatutSimplifie::CONSERVE) restantes[i].push_back(c);
+        }
+        std::sort(restantes[i].begin(), restantes[i].end());
+    }
+    auto attaque = [&](int a, int b) {
+        return std::binary_search(restantes[a].begin(), restantes[a].end(), b);
+    };
+
+    // 2 - Noyau : une attaque (a, b) issue d'un auto-attaquant a est redondante
+    //     - en stable, toujours (a n'est jamais IN, b doit être attaqué par quelqu'un d'autre)
+    //     - en admissible, si b contre-attaque a ou s'auto-attaque
+    vector<vector<int>> noyau(n);
+    for (size_t a = 0; a < n; ++a) {
+        for (int b : restantes[a]) {
+            bool redondante = false;
+            if (autoAttaque[a] && b != static_cast<int>(a)) {
+                redondante = (semantique == SemantiqueCible::STABLE) || attaque(b, static_cast<int>(a)) || autoAttaque[b];
+            }
+            if (redondante) ++stats.attaquesNoyau;
+            else noyau[a].push_back(b);
+        }
+    }
+
+    // 3 - En préférée, un auto-attaquant qui n'attaque plus que lui-même n'a aucun effet
+    if (semantique == SemantiqueCible::PREFEREE) {
+        for (size_t a = 0; a < n; ++a) {
+            if (resultat.statuts[a] == StatutSimplifie::CONSERVE && autoAttaque[a] && noyau[a].size() == 1) {
+                resultat.statuts[a] = StatutSimplifie::REJETE;
+                ++stats.autoAttaquantsRetires;
+            }
+        }
+    }
+
+    // 4 - Clones : des arguments conservés qui ont exactement les mêmes attaquants et les mêmes cibles dans le noyau
+    //     ont le même statut dans toute extension complète ou stable (deux clones ne s'attaquent que s'ils
+    //     s'auto-attaquent) ; seul le premier de chaque groupe reste, les autres partagent son identifiant réduit
+    vector<vector<int>> cibles(n), attaquants(n);
+    vector<uint64_t> signature(n, 0);
+    vector<int> candidats;
+    for (size_t a = 0; a < n; ++a) {
+        if (resultat.statuts[a] != StatutSimplifie::CONSERVE) continue;
+        candidats.push_back(static_cast<int>(a));
+        for (int b : noyau[a]) {
+            if (resultat.statuts[b] != StatutSimplifie::CONSERVE) continue;
+            cibles[a].push_back(b);
+            attaquants[b].push_back(static_cast<int>(a));  // Trié : a est croissant
+        }
+    }
+    for (int a : candidats) {
+        uint64_t h = 1469598103934665603ull;  // Hachage FNV-1a des deux listes, séparées par un marqueur
+        for (int b : cibles[a]) h = (h ^ static_cast<uint64_t>(b)) * 1099511628211ull;
+        h = (h ^ ~uint64_t(0)) * 1099511628211ull;
+        for (int b : attaquants[a]) h = (h ^ static_cast<uint64_t>(b)) * 1099511628211ull;
+        signature[a] = h;
+    }
+    // Tri par signature puis par listes (les collisions de hachage sont départagées), l'identifiant en dernier
+    // pour que le représentant soit le plus petit identifiant du groupe
+    std::sort(candidats.begin(), candidats.end(), [&](int a, int b) {
+        if (signature[a] != signature[b]) return signature[a] < signature[b];
+        if (cibles[a] != cibles[b]) return cibles[a] < cibles[b];
+        if (attaquants[a] != attaquants[b]) return attaquants[a] < attaquants[b];
+        return a < b;
+    });
+    vector<int> representant(n, -1);
+    for (size_t k = 0; k < candidats.size(); ++k) {
+        int a = candidats[k];
+        int precedent = k > 0 ? candidats[k - 1] : -1;
+        bool clone = precedent >= 0 && signature[a] == signature[precedent] && cibles[a] == cibles[precedent]
+                     && attaquants[a] == attaquants[precedent];
+        representant[a] = clone ? representant[precedent] : a;
+        if (clone) ++stats.clonesFusionnes;
+    }
+
+    // 5 - Construction en bloc du système réduit dans l'ordre des identifiants originaux, sans les clones
+    resultat.versReduit.assign(n, -1);
+    ConstructeurSysteme constructeur;
+    for (size_t i = 0; i < n; ++i) {
+        if (resultat.statuts[i] != StatutSimplifie::CONSERVE) continue;
+        if (representant[i] != static_cast<int>(i)) {  // Le représentant, plus petit, a déjà son identifiant
+            resultat.versReduit[i] = resultat.versReduit[representant[i]];
+            continue;
+        }
+        resultat.versReduit[i] = constructeur.ajouterArgument(sa.getNom(static_cast<int>(i)));
+        resultat.versOriginal.push_back(static_cast<int>(i));
+    }
+    for (int a : resultat.versOriginal) {
+        for (int b : cibles[a]) {
+            if (representant[b] != b) continue;
+            constructeur.ajouterAttaque(resultat.versReduit[a], resultat.versReduit[b]);
+            ++stats.attaquesRestantes;
+        }
+    }
+    resultat.systeme = constructeur.finaliser();
+    stats.argumentsRestants = resultat.versOriginal.size();
+    return resultat;
+}
+
+void afficherStatistiques(const StatistiquesSimplification& stats, std::ostream& os) {
+    os << "Simplification :" << std::endl;
+    os << "  - Arguments initiaux : " << stats.argumentsInitiaux << std::endl;
+    os << "  - Attaques initiales : " << stats.attaquesInitiales << std::endl;
+    os << "  - Arguments acceptés (extension fondée) : " << stats.argumentsAcceptes << std::endl;
+    os << "  - Arguments rejetés (attaqués par l'extension fondée) : " << stats.argumentsRejetes << std::endl;
+    os << "  - Auto-attaquants retirés : " << stats.autoAttaquantsRetires << std::endl;
+    os << "  - Attaques retirées par le noyau : " << stats.attaquesNoyau << std::endl;
+    os << "  - Clones fusionnés : " << stats.clonesFusionnes << std::endl;
+    os << "  - Arguments restants : " << stats.argumentsRestants << std::endl;
+    os << "  - Attaques restantes : " << stats.attaquesRestantes << std::endl;
+}
+
+}
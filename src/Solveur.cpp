@@ -4,82 +4,607 @@
 #include "Solveur.hpp"
 #include "Semantiques.hpp"
 #include "Utilitaires.hpp"
+#include "NoyauCompact.hpp"
+#include "DecompositionArborescente.hpp"
+#include "RechercheLocale.hpp"
+#include "Comptage.hpp"
+#include <algorithm>  // std::sort
+#include <stdexcept>  // std::invalid_argument, std::logic_error
+#include <utility>  // std::pair, std::move
+
+
+// Aiguillage vers le moteur adapté, sur des identifiants du système (éventuellement simplifié) donné
+namespace {
+    using Utilitaires::EnsembleIds;
+
+    // Empreinte FNV-1a d'un ensemble trié, pour retrouver un ensemble déjà retenu
+    uint64_t hacherEnsemble(const EnsembleIds& ensemble) {
+        uint64_t h = 14695981039346656037ull;
+        for (int x : ensemble) {
+            h ^= static_cast<uint32_t>(x);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    // Les petits systèmes sont traités par un noyau compact à masques de bits, les autres par programmation dynamique
+    // sur une décomposition arborescente quand leur largeur est faible, et sinon par le moteur générique
+    // La décomposition est fournie par la session (nulle si le système tient dans un noyau)
+    // En stable, le moteur générique est précédé d'une recherche locale quand une extension trouvée suffit à conclure
+    // (DC-ST, existence, contre-exemple DS-ST) : un budget épuisé laisse la main à la recherche complète. En DS-ST, un
+    // argument accepté épuise forcément le budget, d'où celui, bien plus faible, des contre-exemples
+    // Le témoin éventuel est exprimé dans les identifiants du système donné
+    using TemoinIds = std::optional<EnsembleIds>;
+
+    bool moteurVerifierPreferee(const EnsembleIds& S, const SystemeArgumentation& sa, TemoinIds* temoin) {
+        if (NoyauxCompacts::estApplicable(sa)) {
+            return NoyauxCompacts::appliquer(sa, [&](const auto& noyau) { return noyau.verifierPreferee(S, temoin); });
+        }
+        return Semantiques::verifierPreferee(S, sa, temoin);
+    }
+    bool moteurVerifierStable(const EnsembleIds& S, const SystemeArgumentation& sa) {
+        if (NoyauxCompacts::estApplicable(sa)) {
+            return NoyauxCompacts::appliquer(sa, [&](const auto& noyau) { return noyau.verifierStable(S); });
+        }
+        return Semantiques::verifierStable(S, sa);
+    }
+    bool moteurCredulePreferee(int id, const SystemeArgumentation& sa,
+                               const DecompositionArborescente* decomposition, TemoinIds* temoin) {
+        if (NoyauxCompacts::estApplicable(sa)) {
+            return NoyauxCompacts::appliquer(sa, [&](const auto& noyau) { return noyau.credulousPreferred(id, temoin); });
+        }
+        if (decomposition && decomposition->estApplicable()) return decomposition->credulousPreferred(id, temoin);
+        return Semantiques::credulousPreferred(id, sa, temoin);
+    }
+    bool moteurCreduleStable(int id, const SystemeArgumentation& sa,
+                             const DecompositionArborescente* decomposition, TemoinIds* temoin) {
+        if (NoyauxCompacts::estApplicable(sa)) {
+            return NoyauxCompacts::appliquer(sa, [&](const auto& noyau) { return noyau.credulousStable(id, temoin); });
+        }
+        if (decomposition && decomposition->estApplicable()) return decomposition->credulousStable(id, temoin);
+        if (TemoinIds trouvee = RechercheLocale::chercherStable(sa, id)) {
+            if (temoin) *temoin = std::move(trouvee);
+            return true;
+        }
+        return Semantiques::credulousStable(id, sa, temoin);
+    }
+    bool moteurSceptiquePreferee(int id, const SystemeArgumentation& sa, TemoinIds* temoin) {
+        if (NoyauxCompacts::estApplicable(sa)) {
+            return NoyauxCompacts::appliquer(sa, [&](const auto& noyau) { return noyau.skepticalPreferred(id, temoin); });
+        }
+        return Semantiques::skepticalPreferred(id, sa, temoin);
+    }
+    bool moteurSceptiqueStable(int id, const SystemeArgumentation& sa,
+                               const DecompositionArborescente* decomposition, TemoinIds* temoin) {
+        if (NoyauxCompacts::estApplicable(sa)) {
+            return NoyauxCompacts::appliquer(sa, [&](const auto& noyau) { return noyau.skepticalStable(id, temoin); });
+        }
+        if (decomposition && decomposition->estApplicable()) return decomposition->skepticalStable(id, temoin);
+        if (TemoinIds trouvee = RechercheLocale::chercherStable(sa, -1, id)) {
+            if (temoin) *temoin = std::move(trouvee);
+            return false;
+        }
+        return Semantiques::skepticalStable(id, sa, temoin);
+    }
+    bool moteurExisteStable(const SystemeArgumentation& sa,
+                            const DecompositionArborescente* decomposition, TemoinIds* temoin) {
+        if (NoyauxCompacts::estApplicable(sa)) {
+            return NoyauxCompacts::appliquer(sa, [&](const auto& noyau) { return noyau.existeStable(temoin); });
+        }
+        if (decomposition && decomposition->estApplicable()) return decomposition->existeStable(temoin);
+        if (TemoinIds trouvee = RechercheLocale::chercherStable(sa)) {
+            if (temoin) *temoin = std::move(trouvee);
+            return true;
+        }
+        return Semantiques::existeStable(sa, temoin);
+    }
+
+    // Une extension préférée quelconque du système
+    EnsembleIds moteurExtensionPreferee(const SystemeArgumentation& sa) {
+        if (NoyauxCompacts::estApplicable(sa)) {
+            EnsembleIds extension;
+            NoyauxCompacts::appliquer(sa, [&](const auto& noyau) {
+                extension = noyau.extensionPreferee();
+                return true;
+            });
+            return extension;
+        }
+        return Semantiques::extensionPreferee(sa);
+    }
+
+    // Traduit un ensemble d'identifiants originaux vers le système réduit
+    // Retourne false si l'ensemble ne peut pas être une extension : il omet un argument accepté, contient un rejeté,
+    // ou ne contient qu'une partie d'un groupe de clones
+    bool traduireEnsemble(const EnsembleIds& S, const SystemeSimplifie& reduit, EnsembleIds& traduit) {
+        std::vector<bool> estDansS(reduit.statuts.size(), false);
+        for (int id : S) estDansS[id] = true;
+        std::vector<int> taille(reduit.versOriginal.size(), 0), presents(reduit.versOriginal.size(), 0);
+        for (size_t i = 0; i < reduit.statuts.size(); ++i) {
+            StatutSimplifie statut = reduit.statuts[i];
+            if (statut == StatutSimplifie::ACCEPTE && !estDansS[i]) return false;
+            if (statut == StatutSimplifie::REJETE && estDansS[i]) return false;
+            if (statut != StatutSimplifie::CONSERVE) continue;
+            ++taille[reduit.versReduit[i]];
+            if (estDansS[i]) ++presents[reduit.versReduit[i]];
+        }
+        for (size_t r = 0; r < taille.size(); ++r) {
+            if (presents[r] == 0) continue;
+            if (presents[r] != taille[r]) return false;
+            traduit.push_back(static_cast<int>(r));
+        }
+        return true;
+    }
+
+    // Relève dans le système original un ensemble trouvé sur le système réduit : on y ajoute l'extension fondée retirée
+    // par la simplification et les clones de chaque représentant, ce qui préserve admissibilité, stabilité et
+    // maximalité
+    std::optional<EnsembleIds> releverEnsemble(const TemoinIds& temoinReduit, const SystemeSimplifie& reduit) {
+        if (!temoinReduit) return std::nullopt;
+        std::vector<bool> dansTemoin(reduit.versOriginal.size(), false);
+        for (int idReduit : *temoinReduit) dansTemoin[idReduit] = true;
+        EnsembleIds ids;
+        for (size_t i = 0; i < reduit.statuts.size(); ++i) {
+            bool conserve = reduit.statuts[i] == StatutSimplifie::CONSERVE;
+            if (reduit.statuts[i] == StatutSimplifie::ACCEPTE || (conserve && dansTemoin[reduit.versReduit[i]])) {
+                ids.push_back(static_cast<int>(i));
+            }
+        }
+        return ids;
+    }
+}
 
 
 // Initialise le solveur avec une référence au système chargé
-Solveur::Solveur(const SystemeArgumentation& sa) : systeme_(sa) {}
+Solveur::Solveur(const SystemeArgumentation& sa)
+    : systeme_(sa), classification_(ClassesGraphe::classifier(sa)) {}
 
 // Vérifie si l'ensemble d'arguments est une extension préférée
-bool Solveur::verifierExtensionPreferee(const std::vector<std::string>& ensembleNoms) const {
+bool Solveur::verifierExtensionPreferee(const std::vector<std::string>& ensembleNoms, Temoin* temoin) const {
+    // Système cohérent : les extensions préférées sont exactement les stables, vérifiables en temps linéaire
+    if (classification_.estCoherent()) return verifierExtensionStable(ensembleNoms);
     // Conversion des noms en identifiants internes
     Utilitaires::EnsembleIds ids = Utilitaires::convertirNomsEnIds(ensembleNoms, systeme_);
     // Si la taille diffère, c'est qu'un argument demandé n'existe pas dans le graphe
     // Un ensemble contenant un argument inconnu ne peut pas être une extension valide
     if (ids.size() != ensembleNoms.size()) return false;
-    return Semantiques::verifierPreferee(ids, systeme_);  // Appel du moteur
+    // Vérification sur le système simplifié, les arguments fixés par la simplification sont contrôlés ici
+    const SystemeSimplifie& simplifie = reduit(SemantiqueCible::PREFEREE);
+    Utilitaires::EnsembleIds traduit;
+    if (!traduireEnsemble(ids, simplifie, traduit)) return false;
+    TemoinIds temoinReduit;
+    // Appel du moteur
+    bool resultat = moteurVerifierPreferee(traduit, simplifie.systeme, temoin ? &temoinReduit : nullptr);
+    // Une extension préférée confirmée, ou le sur-ensemble admissible qui la réfute, enrichissent la session
+    std::optional<EnsembleIds> ensemble = resultat ? std::optional<EnsembleIds>(ids)
+                                                   : releverEnsemble(temoinReduit, simplifie);
+    if (ensemble) {
+        std::sort(ensemble->begin(), ensemble->end());
+        std::lock_guard<std::mutex> verrou(verrou_);
+        apprendre(resultat ? NatureEnsemble::PREFEREE : NatureEnsemble::ADMISSIBLE, *ensemble);
+    }
+    if (temoin && !resultat && ensemble) *temoin = Utilitaires::convertirIdsEnNoms(*ensemble, systeme_);
+    return resultat;
 }
 // Vérifie si l'ensemble est une extension stable
 bool Solveur::verifierExtensionStable(const std::vector<std::string>& ensembleNoms) const {
     Utilitaires::EnsembleIds ids = Utilitaires::convertirNomsEnIds(ensembleNoms, systeme_);
     // Même vérification d'intégrité
     if (ids.size() != ensembleNoms.size()) return false;
-    return Semantiques::verifierStable(ids, systeme_);  // Appel du moteur
+    const SystemeSimplifie& simplifie = reduit(SemantiqueCible::STABLE);
+    Utilitaires::EnsembleIds traduit;
+    if (!traduireEnsemble(ids, simplifie, traduit)) return false;
+    if (!moteurVerifierStable(traduit, simplifie.systeme)) return false;  // Appel du moteur
+    std::sort(ids.begin(), ids.end());
+    std::lock_guard<std::mutex> verrou(verrou_);
+    apprendre(NatureEnsemble::STABLE, ids);
+    return true;
 }
 
 // Détermine si l'argument donné appartient à au moins une extension préférée
-bool Solveur::acceptationCredulePreferee(const std::string& arg) const {
+bool Solveur::acceptationCredulePreferee(const std::string& arg, Temoin* temoin) const {
+    if (classification_.estCoherent()) return acceptationCreduleStable(arg, temoin);
     // L'argument doit exister dans le graphe
     if (!systeme_.argumentExiste(arg)) return false;
-    // Récupération de l'identifiant et appel du moteur
+    // Récupération de l'identifiant, une requête précédente ou la simplification peuvent suffire à conclure
     int id = systeme_.getId(arg);
-    return Semantiques::credulousPreferred(id, systeme_);
+    if (std::optional<bool> connue = consulter(TacheRetenue::DC_PR, id, temoin)) return *connue;
+    const SystemeSimplifie& simplifie = reduit(SemantiqueCible::PREFEREE);
+    if (simplifie.statuts[id] != StatutSimplifie::CONSERVE) {
+        // Accepté : l'extension fondée, admissible, en est le témoin
+        bool accepte = simplifie.statuts[id] == StatutSimplifie::ACCEPTE;
+        retenir(TacheRetenue::DC_PR, id, accepte, accepte ? releverEnsemble(EnsembleIds{}, simplifie) : std::nullopt,
+                temoin);
+        return accepte;
+    }
+    // Le témoin est toujours demandé au moteur : ce qu'il prouve sert aux requêtes suivantes
+    TemoinIds temoinReduit;
+    bool resultat = moteurCredulePreferee(simplifie.versReduit[id], simplifie.systeme,
+                                          decomposition(SemantiqueCible::PREFEREE), &temoinReduit);
+    retenir(TacheRetenue::DC_PR, id, resultat, releverEnsemble(temoinReduit, simplifie), temoin);
+    return resultat;
 }
 // Détermine si l'argument donné appartient à au moins une extension stable
-bool Solveur::acceptationCreduleStable(const std::string& arg) const {
+bool Solveur::acceptationCreduleStable(const std::string& arg, Temoin* temoin) const {
     // L'argument doit exister dans le graphe
     if (!systeme_.argumentExiste(arg)) return false;
-    // Récupération de l'identifiant et appel du moteur
     int id = systeme_.getId(arg);
-    return Semantiques::credulousStable(id, systeme_);
+    if (std::optional<bool> connue = consulter(TacheRetenue::DC_ST, id, temoin)) return *connue;
+
+    // Chemins polynomiaux : acyclique (l'unique extension est la fondée), symétrique (tout argument est dans un
+    // ensemble sans conflit maximal), biparti (plus grand admissible de chaque côté)
+    if (classification_.acyclique) return acceptationFondee(arg, temoin);
+    if (classification_.symetrique) {
+        if (temoin) *temoin = Utilitaires::convertirIdsEnNoms(ClassesGraphe::extensionNaive(systeme_, id), systeme_);
+        return true;
+    }
+    if (classification_.biparti) {
+        if (!acceptablesBiparti()[id]) return false;
+        if (temoin) {
+            *temoin = Utilitaires::convertirIdsEnNoms(
+                ClassesGraphe::extensionBipartie(systeme_, classification_.cote, id), systeme_);
+        }
+        return true;
+    }
+
+    const SystemeSimplifie& simplifie = reduit(SemantiqueCible::STABLE);
+    // Un argument de l'extension fondée est dans toute extension stable, encore faut-il qu'il en existe une
+    TemoinIds temoinReduit;
+    bool resultat = false;
+    if (simplifie.statuts[id] == StatutSimplifie::ACCEPTE) {
+        resultat = moteurExisteStable(simplifie.systeme, decomposition(SemantiqueCible::STABLE), &temoinReduit);
+    } else if (simplifie.statuts[id] == StatutSimplifie::CONSERVE) {
+        resultat = moteurCreduleStable(simplifie.versReduit[id], simplifie.systeme,
+                                       decomposition(SemantiqueCible::STABLE), &temoinReduit);
+    }
+    retenir(TacheRetenue::DC_ST, id, resultat, releverEnsemble(temoinReduit, simplifie), temoin);
+    return resultat;
 }
 
 // Détermine si l'argument donné appartient à toutes les extensions préférées
-bool Solveur::acceptationSceptiquePreferee(const std::string& arg) const {
+bool Solveur::acceptationSceptiquePreferee(const std::string& arg, Temoin* temoin) const {
+    // Système cohérent : l'acceptation sceptique préférée (Pi2) se ramène à la stable (coNP)
+    if (classification_.estCoherent()) return acceptationSceptiqueStable(arg, temoin);
     // L'argument doit exister dans le graphe
     if (!systeme_.argumentExiste(arg)) return false;
-    // Récupération de l'identifiant et appel du moteur
     int id = systeme_.getId(arg);
-    return Semantiques::skepticalPreferred(id, systeme_);
+    if (std::optional<bool> connue = consulter(TacheRetenue::DS_PR, id, temoin)) return *connue;
+    const SystemeSimplifie& simplifie = reduit(SemantiqueCible::PREFEREE);
+    if (simplifie.statuts[id] != StatutSimplifie::CONSERVE) {
+        // Rejeté : toute extension préférée le réfute, celle du système réduit relevée avec l'extension fondée
+        bool accepte = simplifie.statuts[id] == StatutSimplifie::ACCEPTE;
+        std::optional<EnsembleIds> contreExemple;
+        if (!accepte && temoin) contreExemple = releverEnsemble(moteurExtensionPreferee(simplifie.systeme), simplifie);
+        retenir(TacheRetenue::DS_PR, id, accepte, contreExemple, temoin);
+        return accepte;
+    }
+    TemoinIds temoinReduit;
+    bool resultat = moteurSceptiquePreferee(simplifie.versReduit[id], simplifie.systeme, &temoinReduit);
+    retenir(TacheRetenue::DS_PR, id, resultat, releverEnsemble(temoinReduit, simplifie), temoin);
+    return resultat;
 }
 // Détermine si l'argument donné appartient à toutes les extensions stables
-bool Solveur::acceptationSceptiqueStable(const std::string& arg) const {
+bool Solveur::acceptationSceptiqueStable(const std::string& arg, Temoin* temoin) const {
     // L'argument doit exister dans le graphe
     if (!systeme_.argumentExiste(arg)) return false;
-    // Récupération de l'identifiant et appel du moteur
     int id = systeme_.getId(arg);
-    return Semantiques::skepticalStable(id, systeme_);
+    if (std::optional<bool> connue = consulter(TacheRetenue::DS_ST, id, temoin)) return *connue;
+
+    // Dans les classes cohérentes, une extension stable existe et argId en manque une si et seulement si l'un de ses
+    // attaquants est accepté de manière crédule : l'extension qui contient cet attaquant est le contre-exemple
+    if (classification_.acyclique) return acceptationFondee(arg, temoin);
+    if (classification_.symetrique) {
+        const auto& attaquants = systeme_.getParents()[id];
+        if (attaquants.empty()) return true;
+        if (temoin) {
+            *temoin = Utilitaires::convertirIdsEnNoms(ClassesGraphe::extensionNaive(systeme_, attaquants[0]), systeme_);
+        }
+        return false;
+    }
+    if (classification_.biparti) {
+        const std::vector<bool>& acceptables = acceptablesBiparti();
+        for (int attaquant : systeme_.getParents()[id]) {
+            if (!acceptables[attaquant]) continue;
+            if (temoin) {
+                *temoin = Utilitaires::convertirIdsEnNoms(
+                    ClassesGraphe::extensionBipartie(systeme_, classification_.cote, attaquant), systeme_);
+            }
+            return false;
+        }
+        return true;
+    }
+
+    const SystemeSimplifie& simplifie = reduit(SemantiqueCible::STABLE);
+    if (simplifie.statuts[id] == StatutSimplifie::REJETE) {  // Toute extension stable le réfute, s'il en existe une
+        TemoinIds stable;
+        if (temoin) moteurExisteStable(simplifie.systeme, decomposition(SemantiqueCible::STABLE), &stable);
+        retenir(TacheRetenue::DS_ST, id, false, releverEnsemble(stable, simplifie), temoin);
+        return false;
+    }
+    // Accepté par la simplification : oui si une extension stable existe, et celle trouvée est retenue
+    TemoinIds temoinReduit;
+    const DecompositionArborescente* arbre = decomposition(SemantiqueCible::STABLE);
+    bool resultat = simplifie.statuts[id] == StatutSimplifie::ACCEPTE
+        ? moteurExisteStable(simplifie.systeme, arbre, &temoinReduit)
+        : moteurSceptiqueStable(simplifie.versReduit[id], simplifie.systeme, arbre, &temoinReduit);
+    retenir(TacheRetenue::DS_ST, id, resultat, releverEnsemble(temoinReduit, simplifie), temoin);
+    return resultat;
+}
+
+// Détermine si l'argument donné appartient à l'extension fondée
+bool Solveur::acceptationFondee(const std::string& arg, Temoin* temoin) const {
+    if (!systeme_.argumentExiste(arg)) return false;
+    int id = systeme_.getId(arg);
+    // Calcul linéaire fait une fois par session, sans passer par la simplification ni les moteurs de recherche
+    const std::vector<LabelFonde>& labels = labellingFonde();
+    if (temoin) {  // L'extension fondée justifie aussi bien un oui crédule qu'un non sceptique
+        Utilitaires::EnsembleIds ids;
+        for (size_t i = 0; i < labels.size(); ++i) if (labels[i] == LabelFonde::IN) ids.push_back(static_cast<int>(i));
+        *temoin = Utilitaires::convertirIdsEnNoms(ids, systeme_);
+    }
+    return labels[id] == LabelFonde::IN;
+}
+// Retourne les noms des arguments de l'extension fondée
+std::vector<std::string> Solveur::extensionFondee() const {
+    const std::vector<LabelFonde>& labels = labellingFonde();
+    Utilitaires::EnsembleIds ids;
+    for (size_t i = 0; i < labels.size(); ++i) if (labels[i] == LabelFonde::IN) ids.push_back(static_cast<int>(i));
+    return Utilitaires::convertirIdsEnNoms(ids, systeme_);
+}
+
+// Cherche une extension stable sur le système simplifié, relevée dans le système original
+Solveur::Temoin Solveur::extensionStable() const {
+    // Acyclique : l'extension fondée est l'unique extension stable
+    if (classification_.acyclique) return extensionFondee();
+    const SystemeSimplifie& simplifie = reduit(SemantiqueCible::STABLE);
+    TemoinIds temoinReduit;
+    const DecompositionArborescente* arbre = decomposition(SemantiqueCible::STABLE);
+    if (!moteurExisteStable(simplifie.systeme, arbre, &temoinReduit)) return std::nullopt;
+    std::optional<EnsembleIds> ensemble = releverEnsemble(temoinReduit, simplifie);
+    if (!ensemble) throw std::logic_error("Extension stable trouvée sans être produite par le moteur");
+    {
+        std::lock_guard<std::mutex> verrou(verrou_);
+        apprendre(NatureEnsemble::STABLE, *ensemble);
+    }
+    return Utilitaires::convertirIdsEnNoms(*ensemble, systeme_);
+}
+
+// Compte les extensions sur le système simplifié : l'extension fondée retirée appartient à chacune d'elles
+GrandEntier Solveur::compterExtensions(TypeProbleme probleme, const std::string& argument) const {
+    if (!estComptage(probleme)) throw std::invalid_argument("Pas une tâche de comptage");
+    if (!argument.empty() && !systeme_.argumentExiste(argument)) return 0;
+    // Système cohérent : les extensions préférées sont exactement les stables
+    bool stable = probleme == TypeProbleme::CE_ST || classification_.estCoherent();
+    const SystemeSimplifie& simplifie = reduit(stable ? SemantiqueCible::STABLE : SemantiqueCible::PREFEREE);
+
+    int id = -1;
+    if (!argument.empty()) {
+        int original = systeme_.getId(argument);
+        if (simplifie.statuts[original] == StatutSimplifie::REJETE) return 0;
+        id = simplifie.versReduit[original];  // -1 pour un argument accepté : il est dans toutes les extensions
+    }
+    return stable ? Comptage::compterStables(simplifie.systeme, id) : Comptage::compterPreferees(simplifie.systeme, id);
+}
+
+// Retourne la classe structurelle calculée à la construction
+const ClassificationGraphe& Solveur::classification() const {
+    return classification_;
+}
+
+// Retourne le bilan de la simplification appliquée pour la sémantique donnée
+StatistiquesSimplification Solveur::statistiquesSimplification(SemantiqueCible semantique) const {
+    return reduit(semantique).statistiques;
+}
+
+// Retourne la dernière simplification servie par reduit()
+const SystemeSimplifie* Solveur::derniereSimplification() const {
+    std::lock_guard<std::mutex> verrou(verrou_);
+    return derniereSimplification_;
+}
+
+// Construit le système simplifié à la première demande ; les requêtes concurrentes attendent la fin du calcul
+const SystemeSimplifie& Solveur::reduit(SemantiqueCible semantique) const {
+    std::lock_guard<std::mutex> verrou(verrou_);
+    std::optional<SystemeSimplifie>& cache = semantique == SemantiqueCible::STABLE ? reduitStable_ : reduitPreferee_;
+    if (!cache) cache = Simplification::simplifier(systeme_, semantique);
+    derniereSimplification_ = &*cache;
+    return *cache;
+}
+
+// La décomposition ne sert qu'au-delà des noyaux compacts ; elle reste valide tant que le système réduit est en cache
+const DecompositionArborescente* Solveur::decomposition(SemantiqueCible semantique) const {
+    const SystemeSimplifie& simplifie = reduit(semantique);
+    if (NoyauxCompacts::estApplicable(simplifie.systeme)) return nullptr;
+    std::lock_guard<std::mutex> verrou(verrou_);
+    std::optional<DecompositionArborescente>& cache =
+        semantique == SemantiqueCible::STABLE ? decompositionStable_ : decompositionPreferee_;
+    if (!cache) cache.emplace(simplifie.systeme);
+    return &*cache;
+}
+
+const std::vector<LabelFonde>& Solveur::labellingFonde() const {
+    std::lock_guard<std::mutex> verrou(verrou_);
+    if (!labellingFonde_) labellingFonde_ = Semantiques::labellingFonde(systeme_);
+    return *labellingFonde_;
+}
+
+const std::vector<bool>& Solveur::acceptablesBiparti() const {
+    std::lock_guard<std::mutex> verrou(verrou_);
+    if (!acceptablesBiparti_) {
+        acceptablesBiparti_ = ClassesGraphe::argumentsAcceptablesBiparti(systeme_, classification_.cote);
+    }
+    return *acceptablesBiparti_;
+}
+
+// Une réponse connue suffit, sauf si le témoin demandé la justifie (oui en DC, non en DS) et n'a pas été retenu
+std::optional<bool> Solveur::consulter(TacheRetenue tache, int id, Temoin* temoin) const {
+    std::lock_guard<std::mutex> verrou(verrou_);
+    size_t t = static_cast<size_t>(tache);
+    if (connaissances_.reponses[t].empty() || connaissances_.reponses[t][id] < 0) return std::nullopt;
+    bool reponse = connaissances_.reponses[t][id] == 1;
+    bool credule = tache == TacheRetenue::DC_PR || tache == TacheRetenue::DC_ST;
+    if (temoin && reponse == credule) {
+        int indice = connaissances_.temoins[t][id];
+        if (indice < 0) return std::nullopt;
+        *temoin = Utilitaires::convertirIdsEnNoms(connaissances_.ensembles[indice], systeme_);
+    }
+    return reponse;
+}
+
+void Solveur::retenir(TacheRetenue tache, int id, bool reponse, const std::optional<EnsembleIds>& ensemble,
+                      Temoin* temoin) const {
+    {
+        std::lock_guard<std::mutex> verrou(verrou_);
+        if (ensemble) {
+            // Témoin d'un oui crédule préféré : admissible ; d'un non sceptique préféré : préférée ; en stable : stable
+            NatureEnsemble nature = tache == TacheRetenue::DC_PR ? NatureEnsemble::ADMISSIBLE
+                                  : tache == TacheRetenue::DS_PR ? NatureEnsemble::PREFEREE : NatureEnsemble::STABLE;
+            apprendre(nature, *ensemble);
+        }
+        fixer(tache, id, reponse, -1);
+    }
+    if (temoin && ensemble) *temoin = Utilitaires::convertirIdsEnNoms(*ensemble, systeme_);
+}
+
+// Les membres d'un admissible sont crédules en préférée ; une préférée qui omet un argument le refuse en sceptique ;
+// une stable fait de même pour les deux sémantiques
+void Solveur::apprendre(NatureEnsemble nature, const EnsembleIds& ensemble) const {
+    size_t n = systeme_.getNbArguments();
+    // Un ensemble déjà retenu garde son indice, sinon il prendra le suivant s'il justifie quelque chose
+    uint64_t empreinte = hacherEnsemble(ensemble);
+    int indice = static_cast<int>(connaissances_.ensembles.size());
+    auto [debut, fin] = connaissances_.indices.equal_range(empreinte);
+    for (auto it = debut; it != fin; ++it) {
+        if (connaissances_.ensembles[it->second] == ensemble) indice = it->second;
+    }
+    bool stable = nature == NatureEnsemble::STABLE;
+    bool utile = false;
+    std::vector<bool>& dedans = connaissances_.marques;
+    if (dedans.size() != n) dedans.assign(n, false);
+    for (int x : ensemble) {
+        dedans[x] = true;
+        utile |= fixer(TacheRetenue::DC_PR, x, true, indice);
+        if (stable) utile |= fixer(TacheRetenue::DC_ST, x, true, indice);
+    }
+    if (nature != NatureEnsemble::ADMISSIBLE) {
+        for (size_t x = 0; x < n; ++x) {
+            if (dedans[x]) continue;
+            utile |= fixer(TacheRetenue::DS_PR, static_cast<int>(x), false, indice);
+            if (stable) utile |= fixer(TacheRetenue::DS_ST, static_cast<int>(x), false, indice);
+        }
+    }
+    for (int x : ensemble) dedans[x] = false;
+    if (utile && indice == static_cast<int>(connaissances_.ensembles.size())) {
+        connaissances_.ensembles.push_back(ensemble);
+        connaissances_.indices.emplace(empreinte, indice);
+    }
+}
+
+bool Solveur::fixer(TacheRetenue tache, int id, bool reponse, int indiceEnsemble) const {
+    size_t t = static_cast<size_t>(tache);
+    if (connaissances_.reponses[t].empty()) {  // Première réponse retenue : tables dimensionnées pour tout le système
+        size_t n = systeme_.getNbArguments();
+        for (size_t k = 0; k < NB_TACHES_RETENUES; ++k) {
+            connaissances_.reponses[k].assign(n, -1);
+            connaissances_.temoins[k].assign(n, -1);
+        }
+    }
+    int8_t& connue = connaissances_.reponses[t][id];
+    int& temoin = connaissances_.temoins[t][id];
+    bool change = false;
+    if (connue < 0) {
+        connue = reponse ? 1 : 0;
+        change = true;
+    }
+    if (connue == (reponse ? 1 : 0) && temoin < 0 && indiceEnsemble >= 0) {
+        temoin = indiceEnsemble;
+        change = true;
+    }
+    return change;
+}
+
+// Convertit un nom de tâche en TypeProbleme
+bool Solveur::lireTypeProbleme(const std::string& nom, TypeProbleme& probleme) {
+    static const std::pair<const char*, TypeProbleme> noms[] = {
+        {"VE-PR", TypeProbleme::VE_PR}, {"DC-PR", TypeProbleme::DC_PR}, {"DS-PR", TypeProbleme::DS_PR},
+        {"VE-ST", TypeProbleme::VE_ST}, {"DC-ST", TypeProbleme::DC_ST}, {"DS-ST", TypeProbleme::DS_ST},
+        {"DC-GR", TypeProbleme::DC_GR}, {"DS-GR", TypeProbleme::DS_GR}, {"SE-GR", TypeProbleme::SE_GR},
+        {"SE-ST", TypeProbleme::SE_ST}, {"DC-CO", TypeProbleme::DC_CO}, {"DS-CO", TypeProbleme::DS_CO},
+        {"CE-ST", TypeProbleme::CE_ST}, {"CE-PR", TypeProbleme::CE_PR}
+    };
+    for (const auto& [nomConnu, type] : noms) {
+        if (nom == nomConnu) {
+            probleme = type;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Solveur::estVerification(TypeProbleme probleme) {
+    return probleme == TypeProbleme::VE_PR || probleme == TypeProbleme::VE_ST;
+}
+
+bool Solveur::estComptage(TypeProbleme probleme) {
+    return probleme == TypeProbleme::CE_ST || probleme == TypeProbleme::CE_PR;
 }
 
 // Appelle la bonne méthode selon le TypeProbleme
 bool Solveur::resoudre(TypeProbleme probleme, const std::vector<std::string>& ensembleArgs,
-    const std::string& argument) const {
+    const std::string& argument, Temoin* temoin) const {
+    if (temoin) temoin->reset();
+    bool resultat = resoudreTache(probleme, ensembleArgs, argument, temoin);
+    // Un témoin ne justifie que les réponses oui en DC et non en DS/VE, on l'écarte dans les autres cas
+    if (temoin && *temoin) {
+        bool credule = probleme == TypeProbleme::DC_PR || probleme == TypeProbleme::DC_ST
+                       || probleme == TypeProbleme::DC_GR || probleme == TypeProbleme::DC_CO
+                       || probleme == TypeProbleme::SE_ST;
+        if (resultat != credule || probleme == TypeProbleme::SE_GR) temoin->reset();
+    }
+    return resultat;
+}
+
+// Aiguillage de resoudre, le témoin est transmis aux méthodes qui savent le produire
+bool Solveur::resoudreTache(TypeProbleme probleme, const std::vector<std::string>& ensembleArgs,
+    const std::string& argument, Temoin* temoin) const {
 
     switch (probleme) {
         // Problèmes de vérification (on utilise le vecteur d'arguments)
         case TypeProbleme::VE_PR:
-            return verifierExtensionPreferee(ensembleArgs);
+            return verifierExtensionPreferee(ensembleArgs, temoin);
         case TypeProbleme::VE_ST:
             return verifierExtensionStable(ensembleArgs);
 
         // Problèmes de décision (on utilise l'argument unique)
         case TypeProbleme::DC_PR:
-            return acceptationCredulePreferee(argument);
+            return acceptationCredulePreferee(argument, temoin);
         case TypeProbleme::DS_PR:
-            return acceptationSceptiquePreferee(argument);
+            return acceptationSceptiquePreferee(argument, temoin);
         case TypeProbleme::DC_ST:
-            return acceptationCreduleStable(argument);
+            return acceptationCreduleStable(argument, temoin);
         case TypeProbleme::DS_ST:
-            return acceptationSceptiqueStable(argument);
+            return acceptationSceptiqueStable(argument, temoin);
+
+        // L'extension fondée est l'unique extension fondée et l'intersection des extensions complètes
+        case TypeProbleme::DC_GR:
+        case TypeProbleme::DS_GR:
+        case TypeProbleme::DS_CO:
+            return acceptationFondee(argument, temoin);
+        // Toute extension admissible est incluse dans une complète : DC-CO coïncide avec DC-PR
+        case TypeProbleme::DC_CO:
+            return acceptationCredulePreferee(argument, temoin);
+        // L'extension fondée existe toujours (elle est obtenue par extensionFondee)
+        case TypeProbleme::SE_GR:
+            return true;
+        // Oui si une extension stable existe, l'extension trouvée est le témoin
+        case TypeProbleme::SE_ST: {
+            Temoin extension = extensionStable();
+            if (temoin) *temoin = extension;
+            return extension.has_value();
+        }
+        // Les tâches CE ne répondent pas par oui ou non
+        case TypeProbleme::CE_ST:
+        case TypeProbleme::CE_PR:
+            throw std::invalid_argument("Tâche de comptage : le résultat s'obtient par compterExtensions");
 
         default:
             return false;
@@ -0,0 +1,259 @@
+/* SolveurC.cpp
+ * Implémentation de l'interface C : chaque fonction capture les exceptions du solveur et les convertit en codes de
+ * retour, le message étant conservé pour solveur_derniere_erreur(). */
+
+#include "SolveurC.h"
+#include <cstdlib>  // std::malloc, std::free
+#include <cstring>  // std::memcpy
+#include <exception>  // std::exception
+#include <memory>  // std::unique_ptr
+#include <mutex>  // std::mutex, std::lock_guard
+#include <new>  // std::nothrow, std::bad_alloc
+#include <stdexcept>  // std::invalid_argument, std::runtime_error
+#include <string>  // std::string
+#include <string_view>  // std::string_view
+#include <utility>  // std::move
+#include <vector>  // std::vector
+#include "Parseur.hpp"
+#include "Solveur.hpp"
+#include "SystemeArgumentation.hpp"
+#include "Budget.hpp"
+#include "Reordonnancement.hpp"
+
+
+// La poignée opaque contient le système et la session de résolution qui le référence : créée à la première requête,
+// elle garde ses caches et ses faits appris jusqu'à la prochaine modification du système
+struct SolveurSysteme {
+    explicit SolveurSysteme(SystemeArgumentation sa = SystemeArgumentation()) : systeme(std::move(sa)) {}
+
+    SystemeArgumentation systeme;
+    std::unique_ptr<Solveur> session;
+    std::mutex verrou;  // Protège la création de la session
+};
+
+namespace {
+    thread_local std::string derniereErreur;
+    thread_local double limiteSecondes = 0.0;
+    thread_local size_t limiteMo = 0;
+
+    // Exécute la fonction en convertissant toute exception en code de retour
+    template <typename Fonction>
+    int protegerAppel(Fonction&& fonction) {
+        derniereErreur.clear();
+        try {
+            return fonction();
+        } catch (const BudgetEpuise& e) {
+            derniereErreur = e.what();
+            return SOLVEUR_INCONNU;
+        } catch (const std::exception& e) {
+            derniereErreur = e.what();
+        } catch (...) {
+            derniereErreur = "Erreur inconnue";
+        }
+        return SOLVEUR_ERREUR;
+    }
+
+    // Retourne un nouveau système chargé par la fonction donnée, ou nullptr en cas d'erreur
+    template <typename Fonction>
+    SolveurSysteme* chargerSysteme(Fonction&& charger) {
+        SolveurSysteme* resultat = nullptr;
+        protegerAppel([&] {
+            resultat = new SolveurSysteme{charger()};
+            return SOLVEUR_OUI;
+        });
+        return resultat;
+    }
+
+    // Session du système, créée au besoin
+    const Solveur& session(SolveurSysteme* systeme) {
+        std::lock_guard<std::mutex> verrou(systeme->verrou);
+        if (!systeme->session) systeme->session = std::make_unique<Solveur>(systeme->systeme);
+        return *systeme->session;
+    }
+
+    // Vérifie qu'un pointeur transmis par l'appelant est non nul
+    void exigerNonNul(const void* pointeur, const char* nom) {
+        if (pointeur == nullptr) throw std::invalid_argument(std::string("Paramètre nul : ") + nom);
+    }
+
+    // Copie un texte dans une chaîne allouée avec malloc, pour rester libérable côté C quelle que soit la bibliothèque
+    // standard de l'appelant
+    char* copierEnChaineC(const std::string& texte) {
+        char* resultat = static_cast<char*>(std::malloc(texte.size() + 1));
+        if (resultat == nullptr) throw std::bad_alloc();
+        std::memcpy(resultat, texte.c_str(), texte.size() + 1);
+        return resultat;
+    }
+
+    // Copie une liste de noms au format "a,b,c"
+    char* copierEnChaineC(const std::vector<std::string>& noms) {
+        std::string texte;
+        for (const std::string& nom : noms) {
+            if (!texte.empty()) texte += ',';
+            texte += nom;
+        }
+        return copierEnChaineC(texte);
+    }
+
+    // Lit le nom de tâche et lance une exception s'il est inconnu
+    TypeProbleme lireProbleme(const char* nom) {
+        exigerNonNul(nom, "probleme");
+        TypeProbleme probleme;
+        if (!Solveur::lireTypeProbleme(nom, probleme)) {
+            throw std::invalid_argument(std::string("Probleme inconnu '") + nom + "'");
+        }
+        return probleme;
+    }
+}
+
+
+extern "C" {
+
+SolveurSysteme* solveur_creer(void) {
+    derniereErreur.clear();
+    return new (std::nothrow) SolveurSysteme();
+}
+
+SolveurSysteme* solveur_charger_fichier(const char* chemin) {
+    return chargerSysteme([&] {
+        exigerNonNul(chemin, "chemin");
+        return Parseur::parserFichier(chemin);
+    });
+}
+
+SolveurSysteme* solveur_charger_tampon(const char* contenu, size_t taille) {
+    return chargerSysteme([&] {
+        if (taille > 0) exigerNonNul(contenu, "contenu");
+        return Parseur::parserTampon(std::string_view(contenu, taille), "<tampon>");
+    });
+}
+
+void solveur_liberer(SolveurSysteme* systeme) {
+    delete systeme;
+}
+
+int solveur_ajouter_argument(SolveurSysteme* systeme, const char* nom) {
+    return protegerAppel([&] {
+        exigerNonNul(systeme, "systeme");
+        exigerNonNul(nom, "nom");
+        if (!Parseur::estNomValide(nom)) {
+            throw std::invalid_argument(std::string("Nom d'argument invalide : ") + nom);
+        }
+        systeme->session.reset();
+        return systeme->systeme.ajouterArgument(nom) ? 1 : 0;
+    });
+}
+
+int solveur_ajouter_attaque(SolveurSysteme* systeme, const char* source, const char* cible) {
+    return protegerAppel([&] {
+        exigerNonNul(systeme, "systeme");
+        exigerNonNul(source, "source");
+        exigerNonNul(cible, "cible");
+        const SystemeArgumentation& sa = systeme->systeme;
+        if (!sa.argumentExiste(source) || !sa.argumentExiste(cible)) {
+            throw std::invalid_argument(std::string("Attaque invalide (arguments inexistants) : ")
+                                        + source + " -> " + cible);
+        }
+        systeme->session.reset();
+        return systeme->systeme.ajouterAttaque(source, cible) ? 1 : 0;
+    });
+}
+
+int solveur_reordonner(SolveurSysteme* systeme, const char* ordre) {
+    return protegerAppel([&] {
+        exigerNonNul(systeme, "systeme");
+        exigerNonNul(ordre, "ordre");
+        OrdreArguments valeur;
+        if (!Reordonnancement::lireOrdre(ordre, valeur)) {
+            throw std::invalid_argument(std::string("Ordre inconnu '") + ordre + "'");
+        }
+        systeme->session.reset();
+        Reordonnancement::reordonner(systeme->systeme, valeur);
+        return SOLVEUR_OUI;
+    });
+}
+
+size_t solveur_nb_arguments(const SolveurSysteme* systeme) {
+    return systeme == nullptr ? 0 : systeme->systeme.getNbArguments();
+}
+
+void solveur_configurer_budget(double secondesMax, size_t memoireMaxMo) {
+    limiteSecondes = secondesMax;
+    limiteMo = memoireMaxMo;
+}
+
+int solveur_resoudre(SolveurSysteme* systeme, const char* probleme,
+                     const char* const* arguments, size_t nbArguments) {
+    return solveur_resoudre_temoin(systeme, probleme, arguments, nbArguments, nullptr);
+}
+
+int solveur_resoudre_temoin(SolveurSysteme* systeme, const char* probleme,
+                            const char* const* arguments, size_t nbArguments, char** temoin) {
+    if (temoin) *temoin = nullptr;
+    return protegerAppel([&] {
+        exigerNonNul(systeme, "systeme");
+        TypeProbleme type = lireProbleme(probleme);
+        if (Solveur::estComptage(type)) throw std::invalid_argument("Tâche CE : utiliser solveur_compter");
+        if (nbArguments > 0) exigerNonNul(arguments, "arguments");
+        std::vector<std::string> noms(arguments, arguments + nbArguments);
+
+        Budget::configurer(limiteSecondes, limiteMo);  // Le chronomètre part de chaque requête
+        const Solveur& solveur = session(systeme);
+        Solveur::Temoin ensemble;
+        Solveur::Temoin* demande = temoin ? &ensemble : nullptr;
+        bool resultat;
+        if (Solveur::estVerification(type) || type == TypeProbleme::SE_GR || type == TypeProbleme::SE_ST) {
+            resultat = solveur.resoudre(type, noms, "", demande);
+        } else {
+            if (noms.empty()) throw std::invalid_argument("Aucun argument fourni pour la requête");
+            resultat = solveur.resoudre(type, {}, noms[0], demande);
+        }
+        if (ensemble) *temoin = copierEnChaineC(*ensemble);
+        return resultat ? SOLVEUR_OUI : SOLVEUR_NON;
+    });
+}
+
+char* solveur_extension(SolveurSysteme* systeme, const char* probleme) {
+    char* resultat = nullptr;
+    protegerAppel([&] {
+        exigerNonNul(systeme, "systeme");
+        TypeProbleme type = lireProbleme(probleme);
+        if (type != TypeProbleme::SE_GR && type != TypeProbleme::SE_ST) {
+            throw std::invalid_argument(std::string("Pas une tâche SE : ") + probleme);
+        }
+        Budget::configurer(limiteSecondes, limiteMo);
+        if (type == TypeProbleme::SE_GR) {
+            resultat = copierEnChaineC(session(systeme).extensionFondee());
+            return SOLVEUR_OUI;
+        }
+        Solveur::Temoin extension = session(systeme).extensionStable();
+        if (!extension) throw std::runtime_error("Aucune extension stable");
+        resultat = copierEnChaineC(*extension);
+        return SOLVEUR_OUI;
+    });
+    return resultat;
+}
+
+char* solveur_compter(SolveurSysteme* systeme, const char* probleme, const char* argument) {
+    char* resultat = nullptr;
+    protegerAppel([&] {
+        exigerNonNul(systeme, "systeme");
+        TypeProbleme type = lireProbleme(probleme);
+        if (!Solveur::estComptage(type)) throw std::invalid_argument(std::string("Pas une tâche CE : ") + probleme);
+        Budget::configurer(limiteSecondes, limiteMo);
+        GrandEntier compte = session(systeme).compterExtensions(type, argument ? argument : "");
+        resultat = copierEnChaineC(compte.versChaine());
+        return SOLVEUR_OUI;
+    });
+    return resultat;
+}
+
+void solveur_liberer_chaine(char* chaine) {
+    std::free(chaine);
+}
+
+const char* solveur_derniere_erreur(void) {
+    return derniereErreur.c_str();
+}
+
+}
@@ -2,32 +2,118 @@
  * Implémentation de la classe gérant le système d'argumentation. */
 
 #include "SystemeArgumentation.hpp"
-#include <algorithm>  // pour std::find
-#include <stdexcept>  // pour std::runtime_error
+#include <algorithm>  // pour std::find, std::sort, std::unique
+#include <stdexcept>  // pour std::runtime_error, std::length_error, std::invalid_argument
+#include <limits>  // pour std::numeric_limits
+#include <utility>  // pour std::move
 
 
+namespace {
+    // Hachage FNV-1a 64 bits des caractères du nom
+    uint64_t hacher(std::string_view nom) {
+        uint64_t h = 14695981039346656037ull;
+        for (char c : nom) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+}
+
+
+// Recherche par sondage linéaire dans la table : on s'arrête à la première case libre
+int SystemeArgumentation::trouverId(std::string_view nom) const {
+    if (table_.empty()) return -1;
+    size_t masque = table_.size() - 1;
+    for (size_t i = hacher(nom) & masque; table_[i] != -1; i = (i + 1) & masque) {
+        if (getNom(table_[i]) == nom) return table_[i];
+    }
+    return -1;
+}
+
+// Les vecteurs déplacés sont vides : la source récupère la sentinelle debuts_ == {0}
+SystemeArgumentation::SystemeArgumentation(SystemeArgumentation&& autre) noexcept
+    : arene_(std::move(autre.arene_)),
+      debuts_(std::move(autre.debuts_)),
+      table_(std::move(autre.table_)),
+      adjacence_(std::move(autre.adjacence_)),
+      parents_(std::move(autre.parents_)),
+      rangs_(std::move(autre.rangs_)) {
+    autre.vider();
+}
+
+SystemeArgumentation& SystemeArgumentation::operator=(SystemeArgumentation&& autre) noexcept {
+    if (this != &autre) {
+        arene_ = std::move(autre.arene_);
+        debuts_ = std::move(autre.debuts_);
+        table_ = std::move(autre.table_);
+        adjacence_ = std::move(autre.adjacence_);
+        parents_ = std::move(autre.parents_);
+        rangs_ = std::move(autre.rangs_);
+        autre.vider();
+    }
+    return *this;
+}
+
+// Recrée la table à la taille donnée (puissance de deux) puis réinsère chaque identifiant à partir de son nom
+void SystemeArgumentation::redimensionnerTable(size_t taille) {
+    table_.assign(taille, -1);
+    size_t masque = taille - 1;
+    for (size_t id = 0; id + 1 < debuts_.size(); ++id) {
+        size_t i = hacher(getNom(static_cast<int>(id))) & masque;
+        while (table_[i] != -1) i = (i + 1) & masque;
+        table_[i] = static_cast<int>(id);
+    }
+}
+
 // Ajoute un nouvel argument s'il n'existe pas déjà
-bool SystemeArgumentation::ajouterArgument(const std::string& arg) {
-    if (nomVersId_.find(arg) != nomVersId_.end()) {  // Vérification de l'existence
+bool SystemeArgumentation::ajouterArgument(std::string_view arg) {
+    if (trouverId(arg) != -1) {  // Vérification de l'existence
         return false;
     }
-    int id = static_cast<int>(idVersNom_.size());   // Identifiant correspond à l'index dans le vecteur
-    nomVersId_[arg] = id;  // Enregistrement dans la table de hachage
-    idVersNom_.push_back(arg);  // Enregistrement dans le vecteur de noms
+    if (arene_.size() + arg.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Noms d'arguments trop volumineux pour l'arène");
+    }
+    int id = static_cast<int>(getNbArguments());   // Identifiant correspond à l'index dans le vecteur
+    arene_.append(arg);  // Enregistrement du nom dans l'arène
+    debuts_.push_back(static_cast<uint32_t>(arene_.size()));
+
+    // Table remplie au plus à moitié pour garder des sondages courts
+    if (2 * (static_cast<size_t>(id) + 1) > table_.size()) {
+        redimensionnerTable(table_.empty() ? 16 : 2 * table_.size());  // Réinsère aussi le nouvel argument
+    } else {
+        size_t masque = table_.size() - 1;
+        size_t i = hacher(arg) & masque;
+        while (table_[i] != -1) i = (i + 1) & masque;
+        table_[i] = id;
+    }
 
     adjacence_.resize(id + 1); // Agrandit le vecteur d'adjacence pour le nouveau nœud
     parents_.resize(id + 1);   // Agrandit le vecteur des parents de même
+    if (!rangs_.empty()) rangs_.push_back(id);  // Déclaré en dernier
     return true;
 }
 
+// Réserve la mémoire des structures indexées par identifiant
+void SystemeArgumentation::reserver(size_t nbArguments, size_t tailleNoms) {
+    arene_.reserve(tailleNoms);
+    debuts_.reserve(nbArguments + 1);
+    adjacence_.reserve(nbArguments);
+    parents_.reserve(nbArguments);
+    // Table dimensionnée d'emblée pour éviter les réinsertions successives
+    size_t taille = table_.empty() ? 16 : table_.size();
+    while (taille < 2 * nbArguments) taille *= 2;
+    if (taille > table_.size()) redimensionnerTable(taille);
+}
+
 // Ajoute une attaque entre deux arguments existants
-bool SystemeArgumentation::ajouterAttaque(const std::string& source, const std::string& cible) {
+bool SystemeArgumentation::ajouterAttaque(std::string_view source, std::string_view cible) {
+    int u = trouverId(source); // Récupération identifiant source
+    int v = trouverId(cible);  // Récupération identifiant cible
     // Vérification de l'existence des arguments
-    if (nomVersId_.find(source) == nomVersId_.end() || nomVersId_.find(cible) == nomVersId_.end()) {
+    if (u == -1 || v == -1) {
         return false;
     }
-    int u = nomVersId_[source]; // Récupération identifiant source
-    int v = nomVersId_[cible];  // Récupération identifiant cible
 
     for (int cibleExistante : adjacence_[u]) {  // Vérification de doublon d'attaque
         if (cibleExistante == v) return false;
@@ -40,21 +126,24 @@ bool SystemeArgumentation::ajouterAttaque(const std::string& source, const std::
 
 // Retourne le nombre total d'arguments
 size_t SystemeArgumentation::getNbArguments() const {
-    return idVersNom_.size();
+    return debuts_.size() - 1;
 }
 
 // Récupère l'identifiant associé à un nom d'argument
-int SystemeArgumentation::getId(const std::string& nom) const {
-    auto it = nomVersId_.find(nom);
-    if (it == nomVersId_.end()) {
-        throw std::runtime_error("Argument introuvable : " + nom);
+int SystemeArgumentation::getId(std::string_view nom) const {
+    int id = trouverId(nom);
+    if (id == -1) {
+        throw std::runtime_error("Argument introuvable : " + std::string(nom));
     }
-    return it->second;
+    return id;
 }
 
 // Récupère le nom associé à un identifiant
-const std::string& SystemeArgumentation::getNom(int id) const {
-    return idVersNom_.at(id);
+std::string_view SystemeArgumentation::getNom(int id) const {
+    if (id < 0 || static_cast<size_t>(id) >= getNbArguments()) {
+        throw std::out_of_range("Identifiant d'argument invalide : " + std::to_string(id));
+    }
+    return std::string_view(arene_).substr(debuts_[id], debuts_[id + 1] - debuts_[id]);
 }
 
 // Getter pour le graphe d'adjacence
@@ -67,15 +156,17 @@ const std::vector<std::vector<int>>& SystemeArgumentation::getParents() const {
     return parents_;
 }
 
-// Vérifie si un argument existe via la map
-bool SystemeArgumentation::argumentExiste(const std::string& arg) const {
-    return nomVersId_.find(arg) != nomVersId_.end();
+// Vérifie si un argument existe via la table de hachage
+bool SystemeArgumentation::argumentExiste(std::string_view arg) const {
+    return trouverId(arg) != -1;
 }
 
 // Vérifie l'existence d'une attaque via les noms
-bool SystemeArgumentation::attaqueExiste(const std::string& source, const std::string& cible) const {
-    if (!argumentExiste(source) || !argumentExiste(cible)) return false;
-    return attaqueExiste(nomVersId_.at(source), nomVersId_.at(cible));
+bool SystemeArgumentation::attaqueExiste(std::string_view source, std::string_view cible) const {
+    int u = trouverId(source);
+    int v = trouverId(cible);
+    if (u == -1 || v == -1) return false;
+    return attaqueExiste(u, v);
 }
 
 // Vérifie l'existence d'une attaque via les identifiants
@@ -85,9 +176,13 @@ bool SystemeArgumentation::attaqueExiste(int idSource, int idCible) const {
     return std::find(cibles.begin(), cibles.end(), idCible) != cibles.end();
 }
 
-// Retourne la liste des noms d'arguments
-const std::vector<std::string>& SystemeArgumentation::getArguments() const {
-    return idVersNom_;
+// Reconstruit la liste des noms d'arguments à partir de l'arène
+std::vector<std::string> SystemeArgumentation::getArguments() const {
+    std::vector<std::string> noms(getNbArguments());
+    for (size_t i = 0; i < getNbArguments(); ++i) {
+        noms[getRangDeclaration(static_cast<int>(i))] = getNom(static_cast<int>(i));
+    }
+    return noms;
 }
 
 // Reconstruit la liste de toutes les attaques
@@ -96,56 +191,200 @@ std::vector<std::pair<std::string, std::string>> SystemeArgumentation::getAttaqu
     // Parcours complet du graphe d'adjacence
     for (size_t u = 0; u < adjacence_.size(); ++u) {
         for (int v : adjacence_[u]) {
-            liste.emplace_back(idVersNom_[u], idVersNom_[v]);  // Construction de la paire
+            liste.emplace_back(getNom(static_cast<int>(u)), getNom(v));  // Construction de la paire
         }
     }
     return liste;
 }
 
 // Retourne les noms des attaquants d'un argument
-std::vector<std::string> SystemeArgumentation::getAttaquants(const std::string& arg) const {
+std::vector<std::string> SystemeArgumentation::getAttaquants(std::string_view arg) const {
     std::vector<std::string> result;
-    if (!argumentExiste(arg)) return result;
+    int id = trouverId(arg);
+    if (id == -1) return result;
 
-    int id = nomVersId_.at(arg);
     // Utilisation du graphe inverse parents_ pour éviter de parcourir tout le graphe
     for (int attaquantId : parents_[id]) {
-        result.push_back(idVersNom_[attaquantId]);
+        result.emplace_back(getNom(attaquantId));
     }
     return result;
 }
 
 // Retourne les noms des cibles d'un argument
-std::vector<std::string> SystemeArgumentation::getCibles(const std::string& arg) const {
+std::vector<std::string> SystemeArgumentation::getCibles(std::string_view arg) const {
     std::vector<std::string> result;
-    if (!argumentExiste(arg)) return result;
+    int id = trouverId(arg);
+    if (id == -1) return result;
 
-    int id = nomVersId_.at(arg);
     for (int cibleId : adjacence_[id]) {
-        result.push_back(idVersNom_[cibleId]);
+        result.emplace_back(getNom(cibleId));
     }
     return result;
 }
 
+// Remplace les listes d'adjacence en bloc
+void SystemeArgumentation::remplacerAttaques(std::vector<std::vector<int>> adjacence,
+                                             std::vector<std::vector<int>> parents) {
+    if (adjacence.size() != getNbArguments() || parents.size() != getNbArguments()) {
+        throw std::invalid_argument("Listes d'attaques incohérentes avec le nombre d'arguments");
+    }
+    adjacence_ = std::move(adjacence);
+    parents_ = std::move(parents);
+}
+
+// Reconstruit l'arène, les listes d'attaques (triées) et la table dans le nouvel ordre des identifiants
+void SystemeArgumentation::renumeroter(const std::vector<int>& nouvelId) {
+    size_t n = getNbArguments();
+    if (nouvelId.size() != n) throw std::invalid_argument("Permutation incohérente avec le nombre d'arguments");
+    std::vector<int> ancienId(n, -1);
+    for (size_t i = 0; i < n; ++i) {
+        int j = nouvelId[i];
+        if (j < 0 || static_cast<size_t>(j) >= n || ancienId[j] != -1) {
+            throw std::invalid_argument("La renumérotation n'est pas une permutation");
+        }
+        ancienId[j] = static_cast<int>(i);
+    }
+
+    std::string arene;
+    arene.reserve(arene_.size());
+    std::vector<uint32_t> debuts{0};
+    debuts.reserve(n + 1);
+    std::vector<std::vector<int>> adjacence(n), parents(n);
+    std::vector<int> rangs(n);
+    for (size_t j = 0; j < n; ++j) {
+        int ancien = ancienId[j];
+        arene.append(getNom(ancien));
+        debuts.push_back(static_cast<uint32_t>(arene.size()));
+        for (int c : adjacence_[ancien]) adjacence[j].push_back(nouvelId[c]);
+        for (int p : parents_[ancien]) parents[j].push_back(nouvelId[p]);
+        std::sort(adjacence[j].begin(), adjacence[j].end());
+        std::sort(parents[j].begin(), parents[j].end());
+        rangs[j] = getRangDeclaration(ancien);
+    }
+    arene_ = std::move(arene);
+    debuts_ = std::move(debuts);
+    adjacence_ = std::move(adjacence);
+    parents_ = std::move(parents);
+    rangs_ = std::move(rangs);
+    redimensionnerTable(table_.size());  // Les identifiants ont changé, pas les noms
+}
+
+bool SystemeArgumentation::estRenumerote() const {
+    return !rangs_.empty();
+}
+
+int SystemeArgumentation::getRangDeclaration(int id) const {
+    return rangs_.empty() ? id : rangs_[id];
+}
+
+// Mesure chaque structure d'après sa capacité : une liste d'adjacence compte son en-tête et son tableau réservé
+EmpreinteMemoire SystemeArgumentation::empreinteMemoire() const {
+    auto listes = [](const std::vector<std::vector<int>>& graphe) {
+        size_t octets = graphe.capacity() * sizeof(std::vector<int>);
+        for (const auto& liste : graphe) octets += liste.capacity() * sizeof(int);
+        return octets;
+    };
+    EmpreinteMemoire empreinte;
+    empreinte.arene = arene_.capacity() + 1;  // Caractère nul final compris
+    empreinte.debuts = debuts_.capacity() * sizeof(uint32_t);
+    empreinte.table = table_.capacity() * sizeof(int);
+    empreinte.adjacence = listes(adjacence_);
+    empreinte.parents = listes(parents_);
+    empreinte.rangs = rangs_.capacity() * sizeof(int);
+    return empreinte;
+}
+
 // Vide toutes les structures de données
 void SystemeArgumentation::vider() {
-    nomVersId_.clear();
-    idVersNom_.clear();
+    arene_.clear();
+    debuts_.assign(1, 0);
+    table_.clear();
     adjacence_.clear();
     parents_.clear();
+    rangs_.clear();
 }
 
 // Affiche le système
 void SystemeArgumentation::afficher() const {
     std::cout << "Système d'Argumentation : " << std::endl;
     std::cout << getNbArguments() << " Arguments : " << std::endl;
-    for (size_t i = 0; i < idVersNom_.size(); ++i) {
-        std::cout << "  - " << idVersNom_[i] << " (ID: " << i << ")" << std::endl;
+    for (size_t i = 0; i < getNbArguments(); ++i) {
+        std::cout << "  - " << getNom(static_cast<int>(i)) << " (ID: " << i << ")" << std::endl;
     }
     std::cout << "\nAttaques :" << std::endl;
     for (size_t i = 0; i < adjacence_.size(); ++i) {
         for (int cible : adjacence_[i]) {
-            std::cout << "  - " << idVersNom_[i] << " -> " << idVersNom_[cible] << std::endl;
+            std::cout << "  - " << getNom(static_cast<int>(i)) << " -> " << getNom(cible) << std::endl;
         }
     }
 }
+
+
+// Constructeur en bloc
+ConstructeurSysteme::ConstructeurSysteme(size_t nbArgumentsPrevus, size_t nbAttaquesPrevues) {
+    reserver(nbArgumentsPrevus, nbAttaquesPrevues);
+}
+
+void ConstructeurSysteme::reserver(size_t nbArguments, size_t nbAttaques) {
+    systeme_.reserver(nbArguments);
+    attaques_.reserve(nbAttaques);
+}
+
+int ConstructeurSysteme::ajouterArgument(std::string_view arg) {
+    int id = systeme_.trouverId(arg);
+    if (id != -1) return id;
+    systeme_.ajouterArgument(arg);
+    return static_cast<int>(systeme_.getNbArguments()) - 1;
+}
+
+bool ConstructeurSysteme::ajouterAttaque(std::string_view source, std::string_view cible) {
+    int u = systeme_.trouverId(source);
+    int v = systeme_.trouverId(cible);
+    if (u == -1 || v == -1) return false;
+    attaques_.emplace_back(u, v);  // Pas de recherche de doublon ici
+    return true;
+}
+
+void ConstructeurSysteme::ajouterAttaque(int idSource, int idCible) {
+    attaques_.emplace_back(idSource, idCible);
+}
+
+size_t ConstructeurSysteme::getNbArguments() const {
+    return systeme_.getNbArguments();
+}
+
+int ConstructeurSysteme::trouverId(std::string_view nom) const {
+    return systeme_.trouverId(nom);
+}
+
+// Tri puis unique : les doublons deviennent adjacents, l'adjacence sort triée par cible
+SystemeArgumentation ConstructeurSysteme::finaliser() {
+    std::sort(attaques_.begin(), attaques_.end());
+    attaques_.erase(std::unique(attaques_.begin(), attaques_.end()), attaques_.end());
+
+    // Degrés sortants et entrants pour réserver chaque liste exactement
+    size_t n = systeme_.getNbArguments();
+    std::vector<size_t> degreSortant(n, 0), degreEntrant(n, 0);
+    for (const auto& [u, v] : attaques_) {
+        ++degreSortant[u];
+        ++degreEntrant[v];
+    }
+    std::vector<std::vector<int>> adjacence(n), parents(n);
+    for (size_t i = 0; i < n; ++i) {
+        adjacence[i].reserve(degreSortant[i]);
+        parents[i].reserve(degreEntrant[i]);
+    }
+
+    // Une seule passe sur les attaques remplit les deux sens
+    for (const auto& [u, v] : attaques_) {
+        adjacence[u].push_back(v);
+        parents[v].push_back(u);
+    }
+    systeme_.remplacerAttaques(std::move(adjacence), std::move(parents));
+
+    attaques_.clear();
+    attaques_.shrink_to_fit();
+    SystemeArgumentation resultat = std::move(systeme_);
+    systeme_.vider();
+    return resultat;
+}
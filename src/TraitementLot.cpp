@@ -0,0 +1,266 @@
+/* TraitementLot.cpp
+ * Lecture du fichier de requêtes, regroupement par fichier, groupe de threads et écriture ordonnée des résultats. */
+
+#include "TraitementLot.hpp"
+#include <algorithm>  // std::min, std::max
+#include <atomic>  // std::atomic
+#include <chrono>  // std::chrono::steady_clock
+#include <condition_variable>  // std::condition_variable
+#include <cstdio>  // std::snprintf
+#include <fstream>  // std::ifstream
+#include <iomanip>  // std::fixed, std::setprecision
+#include <memory>  // std::unique_ptr
+#include <mutex>  // std::mutex, std::unique_lock
+#include <sstream>  // std::stringstream
+#include <stdexcept>  // std::runtime_error
+#include <thread>  // std::thread
+#include <unordered_map>  // std::unordered_map
+#include <utility>  // std::pair
+#include <vector>  // std::vector
+#include "Parseur.hpp"
+#include "Solveur.hpp"
+#include "Budget.hpp"
+#include "CompteurMemoire.hpp"
+
+
+namespace {
+    using std::string;
+    using std::vector;
+    using Horloge = std::chrono::steady_clock;
+
+    // Requête lue dans le fichier de lot
+    struct RequeteLot {
+        size_t ligne;  // Numéro de ligne dans le fichier de requêtes
+        string tache, fichier, arguments;
+    };
+
+    // Résultat d'une requête, publié par le thread qui l'a traitée
+    struct ResultatLot {
+        bool pret = false;
+        string reponse;  // YES, NO, UNKNOWN, ERREUR, extension [a,b] (SE) ou nombre d'extensions (CE)
+        string detail;  // Témoin, comptes par argument (CE) ou message d'erreur
+        double millisecondes = 0.0;
+    };
+
+    // Requêtes d'un même fichier, traitées à la suite par un seul thread
+    struct GroupeFichier {
+        string chemin;
+        vector<size_t> requetes;  // Indices dans la liste des requêtes, dans l'ordre du fichier de lot
+    };
+
+    // Découpe une chaîne selon un séparateur, en ignorant les segments vides
+    vector<string> decouper(const string& chaine, char separateur) {
+        vector<string> morceaux;
+        std::stringstream ss(chaine);
+        string segment;
+        while (std::getline(ss, segment, separateur)) {
+            if (!segment.empty()) morceaux.push_back(segment);
+        }
+        return morceaux;
+    }
+
+    // Formate un ensemble d'arguments en [a,b,c]
+    string formaterEnsemble(const vector<string>& ensemble) {
+        string texte = "[";
+        for (size_t i = 0; i < ensemble.size(); ++i) texte += (i > 0 ? "," : "") + ensemble[i];
+        return texte + "]";
+    }
+
+    // Répond à une requête avec le même aiguillage que la ligne de commande
+    void repondre(const Solveur& solveur, TypeProbleme probleme, const string& arguments, bool avecTemoin,
+                  ResultatLot& resultat) {
+        vector<string> args = decouper(arguments, ',');
+        if (probleme == TypeProbleme::SE_GR) {
+            resultat.reponse = formaterEnsemble(solveur.extensionFondee());
+            return;
+        }
+        if (probleme == TypeProbleme::SE_ST) {
+            Solveur::Temoin extension = solveur.extensionStable();
+            resultat.reponse = extension ? formaterEnsemble(*extension) : "NO";
+            return;
+        }
+        if (Solveur::estComptage(probleme)) {
+            resultat.reponse = solveur.compterExtensions(probleme).versChaine();
+            for (const string& arg : args) {
+                if (!resultat.detail.empty()) resultat.detail += ",";
+                resultat.detail += arg + ":" + solveur.compterExtensions(probleme, arg).versChaine();
+            }
+            return;
+        }
+        if (args.empty()) throw std::runtime_error("Aucun argument fourni pour la requête.");
+        Solveur::Temoin temoin;
+        bool oui = Solveur::estVerification(probleme)
+            ? solveur.resoudre(probleme, args, "", avecTemoin ? &temoin : nullptr)
+            : solveur.resoudre(probleme, {}, args[0], avecTemoin ? &temoin : nullptr);
+        resultat.reponse = oui ? "YES" : "NO";
+        if (temoin) resultat.detail = formaterEnsemble(*temoin);
+    }
+
+    // Charge le fichier d'un groupe puis traite ses requêtes une à une, chacune avec son propre budget
+    // publier(i) est appelé dès que le résultat de la requête i est rempli
+    template <typename Publier>
+    void traiterGroupe(const GroupeFichier& groupe, const vector<RequeteLot>& requetes, const OptionsLot& options,
+                       vector<ResultatLot>& resultats, Publier&& publier) {
+        std::unique_ptr<SystemeArgumentation> sa;
+        string erreurChargement;
+        try {
+            Budget::configurer(0.0, 0);
+            CompteurMemoire::PorteePhase phase(CompteurMemoire::Phase::CHARGEMENT);
+            sa = std::make_unique<SystemeArgumentation>(Parseur::parserFichier(groupe.chemin));
+            Reordonnancement::reordonner(*sa, options.ordre);
+        } catch (const std::exception& e) {
+            erreurChargement = e.what();
+        }
+        // La classification faite par le solveur se range d'elle-même en prétraitement
+        CompteurMemoire::PorteePhase phase(CompteurMemoire::Phase::RECHERCHE);
+        std::unique_ptr<Solveur> solveur;
+        if (sa) solveur = std::make_unique<Solveur>(*sa);
+
+        for (size_t indice : groupe.requetes) {
+            const RequeteLot& requete = requetes[indice];
+            ResultatLot& resultat = resultats[indice];
+            Horloge::time_point debut = Horloge::now();
+            Budget::configurer(options.limiteSecondes, options.limiteMo);
+            try {
+                TypeProbleme probleme;
+                if (!solveur) throw std::runtime_error(erreurChargement);
+                if (!Solveur::lireTypeProbleme(requete.tache, probleme)) {
+                    throw std::runtime_error("Probleme inconnu '" + requete.tache + "'");
+                }
+                repondre(*solveur, probleme, requete.arguments, options.temoin, resultat);
+            } catch (const BudgetEpuise& e) {
+                resultat.reponse = "UNKNOWN";
+                resultat.detail = e.what();
+            } catch (const std::exception& e) {
+                resultat.reponse = "ERREUR";
+                resultat.detail = e.what();
+            }
+            resultat.millisecondes = std::chrono::duration<double, std::milli>(Horloge::now() - debut).count();
+            publier(indice);
+        }
+    }
+
+    // Remplace tabulations et retours à la ligne, qui casseraient une ligne TSV
+    string nettoyerTsv(string texte) {
+        for (char& c : texte) if (c == '\t' || c == '\n' || c == '\r') c = ' ';
+        return texte;
+    }
+
+    // Chaîne JSON entre guillemets, caractères spéciaux échappés
+    string chaineJson(const string& texte) {
+        string sortie = "\"";
+        for (char c : texte) {
+            switch (c) {
+                case '"': sortie += "\\\""; break;
+                case '\\': sortie += "\\\\"; break;
+                case '\n': sortie += "\\n"; break;
+                case '\r': sortie += "\\r"; break;
+                case '\t': sortie += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char code[8];
+                        std::snprintf(code, sizeof(code), "\\u%04x", c);
+                        sortie += code;
+                    } else {
+                        sortie += c;
+                    }
+            }
+        }
+        return sortie + "\"";
+    }
+
+    // Écrit la ligne de résultat d'une requête
+    void ecrireResultat(const RequeteLot& requete, const ResultatLot& resultat, FormatLot format,
+                        std::ostream& sortie) {
+        if (format == FormatLot::TSV) {
+            sortie << requete.ligne << '\t' << nettoyerTsv(requete.tache) << '\t' << nettoyerTsv(requete.fichier)
+                   << '\t' << nettoyerTsv(requete.arguments) << '\t' << resultat.reponse << '\t'
+                   << resultat.millisecondes << '\t' << nettoyerTsv(resultat.detail) << '\n';
+            return;
+        }
+        sortie << "{\"ligne\":" << requete.ligne << ",\"tache\":" << chaineJson(requete.tache)
+               << ",\"fichier\":" << chaineJson(requete.fichier) << ",\"arguments\":" << chaineJson(requete.arguments)
+               << ",\"reponse\":" << chaineJson(resultat.reponse) << ",\"temps_ms\":" << resultat.millisecondes;
+        if (!resultat.detail.empty()) sortie << ",\"detail\":" << chaineJson(resultat.detail);
+        sortie << "}\n";
+    }
+}
+
+
+namespace TraitementLot {
+
+bool lireFormat(const std::string& nom, FormatLot& format) {
+    static const std::pair<const char*, FormatLot> noms[] = {{"tsv", FormatLot::TSV}, {"jsonl", FormatLot::JSONL}};
+    for (const auto& [nomConnu, valeur] : noms) {
+        if (nom == nomConnu) {
+            format = valeur;
+            return true;
+        }
+    }
+    return false;
+}
+
+void executer(const std::string& cheminRequetes, const OptionsLot& options, std::ostream& sortie) {
+    std::ifstream entree(cheminRequetes);
+    if (!entree.is_open()) throw std::runtime_error("Impossible d'ouvrir le fichier : " + cheminRequetes);
+
+    // 1 - Lecture des requêtes et regroupement par fichier, dans l'ordre de première apparition
+    vector<RequeteLot> requetes;
+    vector<GroupeFichier> groupes;
+    std::unordered_map<string, size_t> groupeDuFichier;
+    string ligne;
+    for (size_t numero = 1; std::getline(entree, ligne); ++numero) {
+        if (!ligne.empty() && ligne.back() == '\r') ligne.pop_back();
+        if (ligne.empty() || ligne[0] == '#') continue;
+        RequeteLot requete{numero, "", "", ""};
+        std::stringstream ss(ligne);
+        std::getline(ss, requete.tache, '\t');
+        std::getline(ss, requete.fichier, '\t');
+        std::getline(ss, requete.arguments, '\t');
+        auto [place, nouveau] = groupeDuFichier.try_emplace(requete.fichier, groupes.size());
+        if (nouveau) groupes.push_back({requete.fichier, {}});
+        groupes[place->second].requetes.push_back(requetes.size());
+        requetes.push_back(std::move(requete));
+    }
+
+    // 2 - Groupe de threads : chaque thread prend le prochain fichier et traite toutes ses requêtes
+    vector<ResultatLot> resultats(requetes.size());
+    std::mutex verrou;
+    std::condition_variable signal;
+    auto publier = [&](size_t indice) {
+        {
+            std::lock_guard<std::mutex> garde(verrou);
+            resultats[indice].pret = true;
+        }
+        signal.notify_one();
+    };
+    size_t nbThreads = options.nbThreads > 0 ? options.nbThreads
+                                             : std::max<size_t>(1, std::thread::hardware_concurrency());
+    nbThreads = std::min(nbThreads, groupes.size());
+    std::atomic<size_t> suivant{0};
+    vector<std::thread> threads;
+    for (size_t t = 0; t < nbThreads; ++t) {
+        threads.emplace_back([&]() {
+            for (size_t g = suivant++; g < groupes.size(); g = suivant++) {
+                traiterGroupe(groupes[g], requetes, options, resultats, publier);
+            }
+        });
+    }
+
+    // 3 - Écriture dans l'ordre des requêtes, dès que le résultat suivant est prêt
+    sortie << std::fixed << std::setprecision(3);
+    if (options.format == FormatLot::TSV) sortie << "ligne\ttache\tfichier\targuments\treponse\ttemps_ms\tdetail\n";
+    for (size_t i = 0; i < requetes.size(); ++i) {
+        std::unique_lock<std::mutex> garde(verrou);
+        if (!resultats[i].pret) {
+            sortie.flush();  // On vide la sortie avant d'attendre pour que les résultats arrivent au fil de l'eau
+            signal.wait(garde, [&]() { return resultats[i].pret; });
+        }
+        garde.unlock();
+        ecrireResultat(requetes[i], resultats[i], options.format, sortie);
+    }
+    sortie.flush();
+    for (auto& thread : threads) thread.join();
+}
+
+}
@@ -27,8 +27,15 @@ EnsembleIds convertirNomsEnIds(const std::vector<std::string>& noms, const Syste
 std::vector<std::string> convertirIdsEnNoms(const EnsembleIds& ids, const SystemeArgumentation& sa) {
     std::vector<std::string> noms;
     noms.reserve(ids.size());
+    if (sa.estRenumerote()) {  // Les noms sont rendus dans l'ordre de déclaration, quel que soit l'ordre interne
+        EnsembleIds parRang = ids;
+        std::sort(parRang.begin(), parRang.end(),
+                  [&](int a, int b) { return sa.getRangDeclaration(a) < sa.getRangDeclaration(b); });
+        for (int id : parRang) noms.emplace_back(sa.getNom(id));
+        return noms;
+    }
     for (int id : ids) {
-        noms.push_back(sa.getNom(id));  // Accès O(1) au vecteur de noms
+        noms.emplace_back(sa.getNom(id));  // Accès O(1) au nom dans l'arène
     }
     return noms;
 }
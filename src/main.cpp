@@ -8,6 +8,16 @@
 #include "Parseur.hpp"
 #include "Solveur.hpp"
 #include "SystemeArgumentation.hpp"
+#include "Utilitaires.hpp"
+#include "Budget.hpp"
+#include "Reordonnancement.hpp"
+#include "TraitementLot.hpp"
+#include "OracleExhaustif.hpp"
+#include "CompteurMemoire.hpp"
+#include "RechercheLocale.hpp"
+
+// Code de sortie quand une limite de temps ou de mémoire interrompt la résolution (réponse UNKNOWN)
+constexpr int CODE_INCONNU = 2;
 
 
 // Découpe une chaîne "a,b,c" en vecteur {"a", "b", "c"}
@@ -23,11 +33,117 @@ std::vector<std::string> decouperArguments(const std::string& chaineArgs) {
     return result;
 }
 
+// Affiche un ensemble d'arguments au format [a,b,c] suivi d'un retour à la ligne
+void afficherEnsemble(const std::vector<std::string>& ensemble) {
+    std::cout << "[";
+    for (size_t i = 0; i < ensemble.size(); ++i) {
+        std::cout << (i > 0 ? "," : "") << ensemble[i];
+    }
+    std::cout << "]" << std::endl;
+}
+
 // Aide pour l'affichage de l'usage en cas d'erreur
 void afficherUsage(const char* progName) {
-    std::cerr << "Usage : " << progName << " -p PROBLEM -f FILE -a ARGUMENTS" << std::endl;
+    std::cerr << "Usage : " << progName << " -p PROBLEM -f FILE -a ARGUMENTS [--stats] [--witness] "
+              << "[--timeout SECONDS] [--max-memory MB] [--reorder rcm|scc] [--mem-report] [--sls-flips N] "
+              << "[--sls-ds-flips N] [--sls-restart N] [--sls-noise P] [--sls-seed S]" << std::endl;
+    std::cerr << "       " << progName << " --batch QUERIES.tsv [--threads N] [--format tsv|jsonl] [--witness] "
+              << "[--timeout SECONDS] [--max-memory MB] [--reorder rcm|scc]" << std::endl;
+    std::cerr << "       " << progName << " --oracle -f FILE [-p PROBLEM -a ARGUMENTS]" << std::endl;
     std::cerr << "Exemple : " << progName << " -p VE-PR -f file.apx -a a,b,c" << std::endl;
-    std::cerr << "Problemes supportés : VE-PR, DC-PR, DS-PR, VE-ST, DC-ST, DS-ST" << std::endl;
+    std::cerr << "Problemes supportés : VE-PR, DC-PR, DS-PR, VE-ST, DC-ST, DS-ST, DC-GR, DS-GR, SE-GR, SE-ST, DC-CO, "
+              << "DS-CO, CE-ST, CE-PR" << std::endl;
+    std::cerr << "  (SE-GR et SE-ST ne prennent pas d'option -a, elle est facultative pour CE-ST et CE-PR)" << std::endl;
+    std::cerr << "  -f - : lit le système sur l'entrée standard, analysé au fil de la lecture ; format .apx ou numérique "
+              << "(en-tête 'p af N' puis une attaque 'source cible' par ligne, arguments numérotés de 1 à N)" << std::endl;
+    std::cerr << "  --stats : affiche le bilan de la simplification sur stderr" << std::endl;
+    std::cerr << "  --witness : affiche sous la réponse l'extension qui la justifie (oui en DC, non en DS et VE-PR)"
+              << std::endl;
+    std::cerr << "  --timeout, --max-memory : au-delà, affiche UNKNOWN et termine avec le code "
+              << CODE_INCONNU << std::endl;
+    std::cerr << "  --reorder : renumérote les arguments après le chargement pour la localité mémoire "
+              << "(rcm : Cuthill-McKee inverse, scc : composantes fortement connexes en ordre topologique)" << std::endl;
+    std::cerr << "  --batch : une requête TACHE<tab>FICHIER<tab>ARGUMENTS par ligne, chaque fichier chargé une fois ; "
+              << "résultats dans l'ordre des requêtes sur stdout, limites appliquées à chaque requête" << std::endl;
+    std::cerr << "  --mem-report : écrit sur stderr un rapport JSON de la mémoire (octets de chaque structure, "
+              << "allocations et pic du tas par phase : chargement, prétraitement, recherche)" << std::endl;
+    std::cerr << "  --sls-flips : budget de bascules de la recherche locale tentée avant la recherche complète en "
+              << "stable (défaut " << RechercheLocale::Parametres().bascules << ", 0 la désactive) ; --sls-ds-flips : "
+              << "budget du contre-exemple cherché en DS-ST (défaut " << RechercheLocale::Parametres().basculesContreExemple
+              << ", 0 le désactive) ; --sls-restart : bascules avant redémarrage, --sls-noise : probabilité de bascule "
+              << "aléatoire, --sls-seed : graine" << std::endl;
+    std::cerr << "  --oracle : énumération exhaustive des sous-ensembles (au plus " << OracleExhaustif::CAPACITE
+              << " arguments) ; sans -p, affiche toutes les extensions et les réponses DC/DS" << std::endl;
+}
+
+// Rapport --mem-report sur stderr : le système chargé et celui que la session a réellement simplifié pour la requête
+void afficherRapportMemoire(const SystemeArgumentation& sa, const SystemeSimplifie* reduit) {
+    CompteurMemoire::ecrireRapport(std::cerr, CompteurMemoire::bilan(), &sa, reduit ? &reduit->systeme : nullptr);
+}
+
+// Mode --oracle : répond par énumération exhaustive, ou affiche le rapport complet si aucune tâche n'est donnée
+int executerOracle(const std::string& typeProblemeStr, const std::string& cheminFichier,
+                   const std::string& argumentsStr, OrdreArguments ordre) {
+    try {
+        TypeProbleme probleme = TypeProbleme::SE_GR;
+        if (!typeProblemeStr.empty() && !Solveur::lireTypeProbleme(typeProblemeStr, probleme)) {
+            std::cerr << "Erreur : Probleme inconnu '" << typeProblemeStr << "'" << std::endl;
+            return 1;
+        }
+        SystemeArgumentation sa = Parseur::parserFichier(cheminFichier);
+        Reordonnancement::reordonner(sa, ordre);
+        if (!OracleExhaustif::estApplicable(sa)) {
+            std::cerr << "Erreur : L'oracle est limité à " << OracleExhaustif::CAPACITE << " arguments" << std::endl;
+            return 1;
+        }
+        OracleExhaustif::Bilan bilan = OracleExhaustif::enumerer(sa);
+        if (typeProblemeStr.empty()) {
+            OracleExhaustif::afficher(bilan, sa, std::cout);
+            return 0;
+        }
+        if (probleme == TypeProbleme::SE_GR) {
+            afficherEnsemble(Utilitaires::convertirIdsEnNoms(OracleExhaustif::versIds(bilan.fondee), sa));
+            return 0;
+        }
+        if (probleme == TypeProbleme::SE_ST) {
+            if (bilan.stables.empty()) std::cout << "NO" << std::endl;
+            else afficherEnsemble(Utilitaires::convertirIdsEnNoms(OracleExhaustif::versIds(bilan.stables[0]), sa));
+            return 0;
+        }
+
+        // Masque des arguments de la requête : un nom inconnu rend la réponse négative, comme pour le solveur
+        std::vector<std::string> argsVector = decouperArguments(argumentsStr);
+        bool inconnu = false;
+        auto masque = [&](const std::string& nom) {
+            int id = sa.trouverId(nom);
+            inconnu |= id < 0;
+            return id < 0 ? OracleExhaustif::Masque(0) : OracleExhaustif::Masque(1) << id;
+        };
+        if (Solveur::estComptage(probleme)) {
+            std::cout << OracleExhaustif::compter(bilan, probleme) << std::endl;
+            for (const std::string& arg : argsVector) {
+                OracleExhaustif::Masque m = masque(arg);
+                std::cout << arg << " : " << (m ? OracleExhaustif::compter(bilan, probleme, m) : 0) << std::endl;
+            }
+            return 0;
+        }
+        if (argsVector.empty()) {
+            std::cerr << "Erreur : Aucun argument fourni pour la requête." << std::endl;
+            return 1;
+        }
+        OracleExhaustif::Masque requete = 0;
+        if (Solveur::estVerification(probleme)) {
+            for (const std::string& arg : argsVector) requete |= masque(arg);
+        } else {
+            requete = masque(argsVector[0]);
+        }
+        bool resultat = !inconnu && OracleExhaustif::repondre(bilan, probleme, requete);
+        std::cout << (resultat ? "YES" : "NO") << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur : " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
 }
 
 
@@ -36,9 +152,19 @@ int main(int argc, char* argv[]) {
     std::string typeProblemeStr;
     std::string cheminFichier;
     std::string argumentsStr;
+    bool afficherStats = false;
+    bool afficherTemoin = false;
+    double limiteSecondes = 0.0;  // 0 : pas de limite
+    size_t limiteMo = 0;
+    OrdreArguments ordre = OrdreArguments::DECLARATION;
+    bool modeOracle = false;
+    bool rapportMemoire = false;
+    std::string cheminLot;  // Fichier de requêtes du mode --batch
+    OptionsLot optionsLot;
+    RechercheLocale::Parametres rechercheLocale;
 
     // Parsing de la ligne de commande
-    // On attend : -p <prob> -f <file> -a <args>
+    // On attend : -p <prob> -f <file> -a <args> et éventuellement --stats
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
         if (arg == "-p" && i + 1 < argc) {
@@ -47,50 +173,143 @@ int main(int argc, char* argv[]) {
             cheminFichier = argv[++i];
         } else if (arg == "-a" && i + 1 < argc) {
             argumentsStr = argv[++i];
+        } else if (arg == "--stats") {
+            afficherStats = true;
+        } else if (arg == "--witness") {
+            afficherTemoin = true;
+        } else if (arg == "--mem-report") {
+            rapportMemoire = true;
+        } else if (arg == "--oracle") {
+            modeOracle = true;
+        } else if (arg == "--reorder" && i + 1 < argc) {
+            if (!Reordonnancement::lireOrdre(argv[++i], ordre)) {
+                std::cerr << "Erreur : Valeur invalide pour " << arg << std::endl;
+                return 1;
+            }
+        } else if (arg == "--batch" && i + 1 < argc) {
+            cheminLot = argv[++i];
+        } else if (arg == "--format" && i + 1 < argc) {
+            if (!TraitementLot::lireFormat(argv[++i], optionsLot.format)) {
+                std::cerr << "Erreur : Valeur invalide pour " << arg << std::endl;
+                return 1;
+            }
+        } else if ((arg == "--timeout" || arg == "--max-memory" || arg == "--threads" || arg == "--sls-flips"
+                    || arg == "--sls-ds-flips" || arg == "--sls-restart" || arg == "--sls-noise"
+                    || arg == "--sls-seed") && i + 1 < argc) {
+            try {
+                if (arg == "--timeout") limiteSecondes = std::stod(argv[++i]);
+                else if (arg == "--max-memory") limiteMo = std::stoul(argv[++i]);
+                else if (arg == "--sls-flips") rechercheLocale.bascules = std::stoull(argv[++i]);
+                else if (arg == "--sls-ds-flips") rechercheLocale.basculesContreExemple = std::stoull(argv[++i]);
+                else if (arg == "--sls-restart") rechercheLocale.basculesParEssai = std::stoull(argv[++i]);
+                else if (arg == "--sls-noise") rechercheLocale.bruit = std::stod(argv[++i]);
+                else if (arg == "--sls-seed") rechercheLocale.graine = std::stoull(argv[++i]);
+                else optionsLot.nbThreads = std::stoul(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << "Erreur : Valeur invalide pour " << arg << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // Comptage des allocations dès la fin de la lecture des options
+    if (rapportMemoire) CompteurMemoire::activer();
+    // Réglages de la recherche locale, fixés avant le lancement des threads du mode lot
+    RechercheLocale::configurer(rechercheLocale);
+
+    // Mode lot : chaque requête porte sa tâche, son fichier et ses arguments
+    if (!cheminLot.empty()) {
+        optionsLot.temoin = afficherTemoin;
+        optionsLot.limiteSecondes = limiteSecondes;
+        optionsLot.limiteMo = limiteMo;
+        optionsLot.ordre = ordre;
+        try {
+            TraitementLot::executer(cheminLot, optionsLot, std::cout);
+            if (rapportMemoire) CompteurMemoire::ecrireRapport(std::cerr, CompteurMemoire::bilan());
+        } catch (const std::exception& e) {
+            std::cerr << "Erreur : " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Mode oracle : seul le fichier est obligatoire
+    if (modeOracle) {
+        if (cheminFichier.empty()) {
+            std::cerr << "Erreur : Arguments manquants." << std::endl;
+            afficherUsage(argv[0]);
+            return 1;
         }
+        return executerOracle(typeProblemeStr, cheminFichier, argumentsStr, ordre);
     }
 
-    // Vérification que tous les arguments nécessaires sont là
-    if (typeProblemeStr.empty() || cheminFichier.empty() || argumentsStr.empty()) {
+    // Vérification que tous les arguments nécessaires sont là (SE-GR et SE-ST n'ont pas d'argument de requête)
+    bool modeExtension = typeProblemeStr == "SE-GR" || typeProblemeStr == "SE-ST";  // true si on affiche une extension plutôt que YES/NO
+    bool modeComptage = typeProblemeStr == "CE-ST" || typeProblemeStr == "CE-PR";  // true si on affiche un nombre
+    bool sansRequete = modeExtension || modeComptage;  // -a n'est pas obligatoire
+    if (typeProblemeStr.empty() || cheminFichier.empty() || (argumentsStr.empty() && !sansRequete)) {
         std::cerr << "Erreur : Arguments manquants." << std::endl;
         afficherUsage(argv[0]);
         return 1;
     }
 
+    // Les limites courent dès maintenant : le chargement du fichier compte dans le temps alloué
+    Budget::configurer(limiteSecondes, limiteMo);
+
     // Conversion du type de problème
     try {
         TypeProbleme probleme;
-        bool modeEnsemble = false; // true pour VE (ensemble), false pour DC/DS (un seul argument)
-        if (typeProblemeStr == "VE-PR") {
-            probleme = TypeProbleme::VE_PR;
-            modeEnsemble = true;
-        } else if (typeProblemeStr == "VE-ST") {
-            probleme = TypeProbleme::VE_ST;
-            modeEnsemble = true;
-        } else if (typeProblemeStr == "DC-PR") {
-            probleme = TypeProbleme::DC_PR;
-        } else if (typeProblemeStr == "DS-PR") {
-            probleme = TypeProbleme::DS_PR;
-        } else if (typeProblemeStr == "DC-ST") {
-            probleme = TypeProbleme::DC_ST;
-        } else if (typeProblemeStr == "DS-ST") {
-            probleme = TypeProbleme::DS_ST;
-        } else {
+        if (!Solveur::lireTypeProbleme(typeProblemeStr, probleme)) {
             std::cerr << "Erreur : Probleme inconnu '" << typeProblemeStr << "'" << std::endl;
             return 1;
         }
+        bool modeEnsemble = Solveur::estVerification(probleme); // true pour VE (ensemble), false pour DC/DS
 
         // Chargement et Construction du Système
-        SystemeArgumentation sa = Parseur::parserFichier(cheminFichier);
+        SystemeArgumentation sa;
+        {
+            CompteurMemoire::PorteePhase phase(CompteurMemoire::Phase::CHARGEMENT);
+            sa = Parseur::parserFichier(cheminFichier);
+            // Renumérotation éventuelle, invisible au-dessus : les noms suivent leurs arguments
+            Reordonnancement::reordonner(sa, ordre);
+        }
+        // Tout ce qui suit est de la recherche, sauf la classification et la simplification qui se déclarent seules
+        CompteurMemoire::PorteePhase phase(CompteurMemoire::Phase::RECHERCHE);
         // Initialisation du solveur
         Solveur solveur(sa);
+
+        // Pour SE, on affiche l'extension au format [a,b,c], ou NO s'il n'existe aucune extension stable
+        if (modeExtension) {
+            if (probleme == TypeProbleme::SE_GR) {
+                afficherEnsemble(solveur.extensionFondee());
+            } else if (Solveur::Temoin extension = solveur.extensionStable()) {
+                afficherEnsemble(*extension);
+            } else {
+                std::cout << "NO" << std::endl;
+            }
+            if (rapportMemoire) afficherRapportMemoire(sa, solveur.derniereSimplification());
+            return 0;
+        }
+
         // Préparation des données pour le solveur
         std::vector<std::string> argsVector = decouperArguments(argumentsStr);
+
+        // Pour CE, le nombre d'extensions, puis pour chaque argument de -a le nombre de celles qui le contiennent
+        if (modeComptage) {
+            std::cout << solveur.compterExtensions(probleme).versChaine() << std::endl;
+            for (const std::string& arg : argsVector) {
+                std::cout << arg << " : " << solveur.compterExtensions(probleme, arg).versChaine() << std::endl;
+            }
+            if (rapportMemoire) afficherRapportMemoire(sa, solveur.derniereSimplification());
+            return 0;
+        }
         bool resultat = false;
+        Solveur::Temoin temoin;
+        Solveur::Temoin* demandeTemoin = afficherTemoin ? &temoin : nullptr;
 
         if (modeEnsemble) {
             // Pour VE, on passe tout le vecteur
-            resultat = solveur.resoudre(probleme, argsVector, "");
+            resultat = solveur.resoudre(probleme, argsVector, "", demandeTemoin);
         } else {
             // Pour DC et DS, on attend un seul argument
             if (argsVector.empty()) {
@@ -99,12 +318,34 @@ int main(int argc, char* argv[]) {
             }
             // On prend le premier argument de la liste (même si l'utilisateur a mis a,b,c par erreur)
             const std::string& argCible = argsVector[0];
-            resultat = solveur.resoudre(probleme, {}, argCible);
+            resultat = solveur.resoudre(probleme, {}, argCible, demandeTemoin);
         }
 
         // Affichage du résultat final
         std::cout << (resultat ? "YES" : "NO") << std::endl;
+        // Témoin sur une seconde ligne, seulement si la recherche en a produit un
+        if (temoin) afficherEnsemble(*temoin);
+
+        // Simplification réellement utilisée par la requête, relevée avant que --stats n'en calcule une autre
+        const SystemeSimplifie* simplifie = solveur.derniereSimplification();
+        // Bilan de la simplification sur la sortie d'erreur pour ne pas perturber la réponse
+        if (afficherStats) {
+            std::cerr << "Classe du graphe : " << solveur.classification().nom() << std::endl;
+            // Les tâches qui n'en ont pas eu besoin (fondée, système acyclique) affichent celle de leur sémantique
+            bool stable = typeProblemeStr.substr(3) == "ST";
+            Simplification::afficherStatistiques(simplifie ? simplifie->statistiques
+                : solveur.statistiquesSimplification(stable ? SemantiqueCible::STABLE : SemantiqueCible::PREFEREE),
+                std::cerr);
+        }
+        if (rapportMemoire) afficherRapportMemoire(sa, simplifie);
 
+    } catch (const BudgetEpuise& e) {
+        // La recherche a été interrompue proprement : on répond UNKNOWN avec le bilan partiel
+        Budget::Statistiques stats = Budget::statistiques();
+        std::cout << "UNKNOWN" << std::endl;
+        std::cerr << e.what() << " : " << stats.noeuds << " noeuds explorés en " << stats.secondes
+                  << " s, pic mémoire " << stats.memoireMo << " Mo" << std::endl;
+        return CODE_INCONNU;
     } catch (const std::exception& e) {
         std::cerr << "Erreur : " << e.what() << std::endl;
         return 1;
@@ -1,13 +1,24 @@
 """ verifier_tout.py : génère exhaustivement tous les sous-ensembles d’arguments (soit 2^N), et en vérifie le statut
-à l’aide du solveur. À ne lancer que sur des petits systèmes d'argumentation pour verifier la logique. """
+à l’aide du solveur. À ne lancer que sur des petits systèmes d'argumentation pour verifier la logique.
+Les réponses sont ensuite comparées à celles de l'oracle exhaustif intégré (solveur --oracle, au plus 32 arguments) ;
+au-delà de MAX_SOUS_ENSEMBLES arguments, VE n'est plus testé que sur les extensions complètes données par l'oracle.
+Au-delà de 32 arguments, chaque composante connexe est écrite dans son propre fichier et les réponses sur le système
+entier sont comparées à celles obtenues sur la composante de l'argument. """
 
 import subprocess
 import sys
 import itertools
 import os
+import ctypes
+import tempfile
+import math
 
 SOLVEUR_PATH = "./solveur"  # Chemin vers l'exécutable
+BIBLIOTHEQUE_PATH = "./libsolveur.so"  # Bibliothèque partagée, utilisée en priorité si elle existe
 FICHIER_APX = "tests/cas_test/test_af5.apx"  # Fichier par défaut
+MAX_SOUS_ENSEMBLES = 12  # Nombre d'arguments au-delà duquel on ne parcourt plus les 2^N sous-ensembles
+MAX_ORACLE = 32  # Nombre d'arguments au-delà duquel l'oracle refuse le système
+DELAI_REQUETE = 10  # Secondes accordées à chaque requête, une réponse UNKNOWN est une erreur
 
 def get_arguments(fichier_apx):
     """ Extrait la liste des arguments depuis le fichier apx. """
@@ -20,35 +31,274 @@ def get_arguments(fichier_apx):
                 args.append(arg)
     return sorted(args)
 
+def get_attaques(fichier_apx):
+    """ Extrait la liste des attaques (source, cible) depuis le fichier apx. """
+    attaques = []
+    with open(fichier_apx, 'r') as f:
+        for line in f:
+            if line.startswith("att("):
+                source, cible = line.split("(")[1].split(")")[0].split(",")
+                attaques.append((source.strip(), cible.strip()))
+    return attaques
+
 def powerset(iterable):
     """ Génère tous les sous-ensembles possibles. """
     s = list(iterable)
     return itertools.chain.from_iterable(itertools.combinations(s, r) for r in range(len(s)+1))
 
+class SolveurEnProcessus:
+    """ Appels directs à libsolveur.so via ctypes : chaque fichier n'est chargé qu'une fois, sans processus fils. """
+    def __init__(self, chemin):
+        self.lib = ctypes.CDLL(chemin)
+        self.lib.solveur_charger_fichier.restype = ctypes.c_void_p
+        self.lib.solveur_charger_fichier.argtypes = [ctypes.c_char_p]
+        self.lib.solveur_resoudre.restype = ctypes.c_int
+        self.lib.solveur_resoudre.argtypes = [ctypes.c_void_p, ctypes.c_char_p,
+                                              ctypes.POINTER(ctypes.c_char_p), ctypes.c_size_t]
+        self.lib.solveur_resoudre_temoin.restype = ctypes.c_int
+        self.lib.solveur_resoudre_temoin.argtypes = [ctypes.c_void_p, ctypes.c_char_p,
+                                                     ctypes.POINTER(ctypes.c_char_p), ctypes.c_size_t,
+                                                     ctypes.POINTER(ctypes.c_void_p)]
+        self.lib.solveur_extension.restype = ctypes.c_void_p  # Pointeur brut, pour pouvoir le libérer
+        self.lib.solveur_extension.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+        self.lib.solveur_compter.restype = ctypes.c_void_p
+        self.lib.solveur_compter.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.c_char_p]
+        self.lib.solveur_liberer_chaine.argtypes = [ctypes.c_void_p]
+        self.lib.solveur_liberer.argtypes = [ctypes.c_void_p]
+        self.lib.solveur_derniere_erreur.restype = ctypes.c_char_p
+        self.lib.solveur_configurer_budget.argtypes = [ctypes.c_double, ctypes.c_size_t]
+        self.lib.solveur_configurer_budget(DELAI_REQUETE, 0)
+        self.systemes = {}
+
+    def systeme(self, fichier):
+        if fichier not in self.systemes:
+            handle = self.lib.solveur_charger_fichier(fichier.encode())
+            if not handle:
+                raise RuntimeError(self.lib.solveur_derniere_erreur().decode())
+            self.systemes[fichier] = handle
+        return self.systemes[fichier]
+
+    def resoudre(self, probleme, fichier, args_str):
+        noms = [a.encode() for a in args_str.split(",") if a]
+        tableau = (ctypes.c_char_p * len(noms))(*noms)
+        code = self.lib.solveur_resoudre(self.systeme(fichier), probleme.encode(), tableau, len(noms))
+        return {1: "YES", 0: "NO", 2: "UNKNOWN"}.get(code, "ERREUR")
+
+    def temoin(self, probleme, fichier, arg):
+        # Poignée neuve : le témoin doit venir de la recherche, pas d'un ensemble retenu par une requête précédente
+        systeme = self.lib.solveur_charger_fichier(fichier.encode())
+        tableau = (ctypes.c_char_p * 1)(arg.encode())
+        pointeur = ctypes.c_void_p()
+        self.lib.solveur_resoudre_temoin(systeme, probleme.encode(), tableau, 1, ctypes.byref(pointeur))
+        self.lib.solveur_liberer(systeme)
+        if not pointeur.value:
+            return None
+        contenu = ctypes.string_at(pointeur.value).decode()
+        self.lib.solveur_liberer_chaine(pointeur.value)
+        return set(contenu.split(",")) if contenu else set()
+
+    def extension(self, probleme, fichier):
+        pointeur = self.lib.solveur_extension(self.systeme(fichier), probleme.encode())
+        if not pointeur:
+            erreur = self.lib.solveur_derniere_erreur().decode()
+            if erreur == "Aucune extension stable":
+                return None
+            raise RuntimeError(erreur)
+        contenu = ctypes.string_at(pointeur).decode()
+        self.lib.solveur_liberer_chaine(pointeur)
+        return set(contenu.split(",")) if contenu else set()
+
+    def compter(self, probleme, fichier):
+        pointeur = self.lib.solveur_compter(self.systeme(fichier), probleme.encode(), None)
+        if not pointeur:
+            raise RuntimeError(self.lib.solveur_derniere_erreur().decode())
+        contenu = ctypes.string_at(pointeur).decode()
+        self.lib.solveur_liberer_chaine(pointeur)
+        return int(contenu)
+
+SOLVEUR_BIBLIOTHEQUE = SolveurEnProcessus(BIBLIOTHEQUE_PATH) if os.path.exists(BIBLIOTHEQUE_PATH) else None
+
+def call_reponse(probleme, fichier, args_str):
+    """ Appelle le solveur C++ et retourne sa réponse : YES, NO ou UNKNOWN si le délai est dépassé. """
+    if SOLVEUR_BIBLIOTHEQUE is not None:
+        return SOLVEUR_BIBLIOTHEQUE.resoudre(probleme, fichier, args_str)
+    cmd = [SOLVEUR_PATH, "-p", probleme, "-f", fichier, "-a", args_str, "--timeout", str(DELAI_REQUETE)]
+    try:
+        result = subprocess.run(cmd, capture_output=True, text=True)
+        return result.stdout.strip()
+    except Exception as e:
+        print(f"Erreur appel solveur: {e}")
+        return "ERREUR"
+
 def call_solveur(probleme, fichier, args_str):
     """ Appelle le solveur C++ et retourne True si YES. """
-    cmd = [SOLVEUR_PATH, "-p", probleme, "-f", fichier, "-a", args_str]
+    return call_reponse(probleme, fichier, args_str) == "YES"
+
+def call_temoin(probleme, fichier, arg):
+    """ Appelle le solveur C++ avec --witness et retourne le témoin affiché sous la réponse (None s'il n'y en a pas). """
+    if SOLVEUR_BIBLIOTHEQUE is not None:
+        return SOLVEUR_BIBLIOTHEQUE.temoin(probleme, fichier, arg)
+    cmd = [SOLVEUR_PATH, "-p", probleme, "-f", fichier, "-a", arg, "--witness"]
+    try:
+        lignes = subprocess.run(cmd, capture_output=True, text=True).stdout.split()
+        if len(lignes) < 2:
+            return None
+        contenu = lignes[1][1:-1]  # Retire les crochets
+        return set(contenu.split(",")) if contenu else set()
+    except Exception as e:
+        print(f"Erreur appel solveur: {e}")
+        return None
+
+def call_extension(probleme, fichier):
+    """ Appelle le solveur C++ pour une tâche SE et retourne l'extension affichée (None pour NO). """
+    if SOLVEUR_BIBLIOTHEQUE is not None:
+        return SOLVEUR_BIBLIOTHEQUE.extension(probleme, fichier)
+    cmd = [SOLVEUR_PATH, "-p", probleme, "-f", fichier]
     try:
         result = subprocess.run(cmd, capture_output=True, text=True)
-        return result.stdout.strip() == "YES"
+        if result.stdout.strip() == "NO":
+            return None
+        contenu = result.stdout.strip()[1:-1]  # Retire les crochets
+        return set(contenu.split(",")) if contenu else set()
     except Exception as e:
         print(f"Erreur appel solveur: {e}")
-        return False
+        return set()
+
+def call_comptage(probleme, fichier):
+    """ Appelle le solveur C++ pour une tâche CE et retourne le nombre d'extensions. """
+    if SOLVEUR_BIBLIOTHEQUE is not None:
+        return SOLVEUR_BIBLIOTHEQUE.compter(probleme, fichier)
+    cmd = [SOLVEUR_PATH, "-p", probleme, "-f", fichier]
+    try:
+        result = subprocess.run(cmd, capture_output=True, text=True)
+        return int(result.stdout.strip())
+    except Exception as e:
+        print(f"Erreur appel solveur: {e}")
+        return -1
+
+def call_oracle(fichier):
+    """ Lance l'oracle exhaustif et retourne ses listes d'extensions et d'arguments acceptés, indexées par titre. """
+    cmd = [SOLVEUR_PATH, "--oracle", "-f", fichier]
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        return None
+    rapport = {}
+    for ligne in result.stdout.splitlines():
+        titre, _, valeur = ligne.partition(" : ")
+        titre = titre.split(" (")[0]  # "Extensions préférées (2)" -> "Extensions préférées"
+        ensembles = [set(e.strip()[1:].split(",")) - {""} for e in valeur.split("]") if e.strip()]
+        rapport[titre] = ensembles
+    return rapport
+
+def composantes(arguments, attaques):
+    """ Regroupe les arguments par composante faiblement connexe (union-find). """
+    parent = {a: a for a in arguments}
+    def racine(a):
+        while parent[a] != a:
+            parent[a] = parent[parent[a]]
+            a = parent[a]
+        return a
+    for source, cible in attaques:
+        parent[racine(source)] = racine(cible)
+    groupes = {}
+    for a in arguments:
+        groupes.setdefault(racine(a), []).append(a)
+    return list(groupes.values())
+
+def verifier_par_composantes(fichier, arguments):
+    """ Compare les réponses sur le système entier à celles obtenues sur la composante de chaque argument : les extensions
+    du système sont les unions d'une extension par composante. Sans extension stable dans une composante, il n'y en a
+    aucune dans le système, et le solveur répond alors NO en DC-ST comme en DS-ST. """
+    attaques = get_attaques(fichier)
+    groupes = composantes(arguments, attaques)
+    print(f"Vérification par composantes : {len(groupes)} composantes")
+    with tempfile.TemporaryDirectory() as dossier:
+        fichiers = {}  # Fichier de la composante de chaque argument
+        membres_par_fichier = {}
+        for k, groupe in enumerate(groupes):
+            chemin = os.path.join(dossier, f"composante{k}.apx")
+            membres = set(groupe)
+            membres_par_fichier[chemin] = membres
+            with open(chemin, "w") as f:
+                for a in groupe:
+                    f.write(f"arg({a}).\n")
+                for source, cible in attaques:
+                    if source in membres:
+                        f.write(f"att({source},{cible}).\n")
+            for a in groupe:
+                fichiers[a] = chemin
+        chemins = sorted(membres_par_fichier)
+        stables = {c: call_extension("SE-ST", c) for c in chemins}
+        toutes_stables = all(e is not None for e in stables.values())
+
+        for probleme in ("DC-PR", "DS-PR", "DC-ST", "DS-ST", "DC-CO", "DS-CO"):
+            erreurs = []
+            for arg in arguments:
+                obtenu = call_reponse(probleme, fichier, arg)
+                attendu = call_reponse(probleme, fichiers[arg], arg)
+                if probleme in ("DC-ST", "DS-ST") and not toutes_stables:
+                    attendu = "NO"
+                if obtenu != attendu:
+                    erreurs.append(f"{arg} : {obtenu} au lieu de {attendu}")
+            print(f"  - {probleme} : {'OK' if not erreurs else 'ERREUR, ' + ', '.join(erreurs[:5])}")
+
+        # Témoins d'un non sceptique, demandés sur une poignée neuve : chaque restriction doit être une extension de sa
+        # composante, et celle de la composante de l'argument doit l'omettre
+        for probleme, verification in (("DS-PR", "VE-PR"), ("DS-ST", "VE-ST")):
+            if probleme == "DS-ST" and not toutes_stables:
+                continue
+            erreurs = []
+            for arg in arguments:
+                if call_reponse(probleme, fichier, arg) != "NO":
+                    continue
+                temoin = call_temoin(probleme, fichier, arg)
+                valide = temoin is not None and arg not in temoin and all(
+                    call_solveur(verification, c, ",".join(sorted(temoin & membres_par_fichier[c]))) for c in chemins)
+                if not valide:
+                    erreurs.append(f"{arg} : {temoin}")
+            print(f"  - Témoins {probleme} : {'OK' if not erreurs else 'ERREUR, ' + ', '.join(erreurs[:5])}")
+
+        # Comptage : produit des nombres d'extensions des composantes
+        for probleme in ("CE-PR", "CE-ST"):
+            compte = call_comptage(probleme, fichier)
+            attendu = math.prod(call_comptage(probleme, c) for c in chemins)
+            print(f"  - {probleme} : {compte} ({'OK' if compte == attendu else f'ERREUR, {attendu} attendues'})")
+
+        # SE-GR : union des extensions fondées ; SE-ST : chaque restriction doit être stable dans sa composante
+        fondee = call_extension("SE-GR", fichier)
+        attendue = set().union(*(call_extension("SE-GR", c) for c in chemins))
+        print(f"  - SE-GR : {'OK' if fondee == attendue else f'ERREUR, attendu {attendue}'}")
+        extension = call_extension("SE-ST", fichier)
+        if extension is None:
+            correct = not toutes_stables
+        else:
+            correct = toutes_stables and all(call_solveur("VE-ST", c, ",".join(sorted(extension & membres_par_fichier[c])))
+                                             for c in chemins)
+        print(f"  - SE-ST : {'OK' if correct else 'ERREUR'}")
 
 def main():
-    fichier = FICHIER_APX
-    if len(sys.argv) > 1:
-        fichier = sys.argv[1]
+    # Plusieurs fichiers peuvent être donnés, vérifiés l'un après l'autre
+    for fichier in sys.argv[1:] or [FICHIER_APX]:
+        verifier(fichier)
+
+def verifier(fichier):
     if not os.path.exists(fichier):
         print(f"Erreur: Fichier {fichier} introuvable.")
         return
     print(f"Analyse de : {fichier}")
     arguments = get_arguments(fichier)
+    if len(arguments) > MAX_ORACLE:
+        verifier_par_composantes(fichier, arguments)
+        return
+    oracle = call_oracle(fichier)
 
-    # Vérification VE
+    # Vérification VE : tous les sous-ensembles (2^N) si N est petit, sinon les extensions complètes de l'oracle
     extensions_pref = []
     extensions_stable = []
-    for i, subset in enumerate(powerset(arguments)):  # On teste tous les sous-ensembles (2^N)
+    candidats = powerset(arguments)
+    if len(arguments) > MAX_SOUS_ENSEMBLES and oracle is not None:
+        candidats = [tuple(sorted(e)) for e in oracle["Extensions complètes"]]
+    for subset in candidats:
         args_str = ",".join(subset)
         if call_solveur("VE-PR", fichier, args_str):  # VE-PR
             extensions_pref.append(set(subset))
@@ -58,11 +308,20 @@ def main():
     print(f"  - VE-PR : {extensions_pref}")
     print(f"  - VE-ST : {extensions_stable}")
 
+    # Comptage CE, qui doit retrouver le nombre d'extensions énumérées
+    print("Comptage :")
+    for probleme, extensions in (("CE-PR", extensions_pref), ("CE-ST", extensions_stable)):
+        compte = call_comptage(probleme, fichier)
+        statut = "OK" if compte == len(extensions) else f"ERREUR, {len(extensions)} attendues"
+        print(f"  - {probleme} : {compte} ({statut})")
+
     # Décision DC/DS
     dc_pr = []
     ds_pr = []
     dc_st = []
     ds_st = []
+    dc_co = []
+    ds_co = []
     for arg in arguments:
         if call_solveur("DC-PR", fichier, arg):  # DC-PR
             dc_pr.append(arg)
@@ -72,12 +331,53 @@ def main():
             dc_st.append(arg)
         if call_solveur("DS-ST", fichier, arg):  # DS-ST
             ds_st.append(arg)
+        if call_solveur("DC-CO", fichier, arg):  # DC-CO
+            dc_co.append(arg)
+        if call_solveur("DS-CO", fichier, arg):  # DS-CO
+            ds_co.append(arg)
+    print(f"  - SE-GR : {call_extension('SE-GR', fichier)}")
+    extension_stable = call_extension("SE-ST", fichier)
+    print(f"  - SE-ST : {extension_stable}")
     print("Acceptabilité crédule :")
     print(f"  - DC-PR : {dc_pr}")
     print(f"  - DC-ST : {dc_st}")
+    print(f"  - DC-CO : {dc_co}")
     print("Acceptabilité sceptique :")
     print(f"  - DS-PR : {ds_pr}")
     print(f"  - DS-ST : {ds_st}")
+    print(f"  - DS-CO : {ds_co}")
+
+    # Comparaison avec l'oracle exhaustif
+    if oracle is None:
+        print("Oracle : indisponible (plus de 32 arguments ?)")
+        return
+    print("Oracle :")
+    comparaisons = (
+        ("VE-PR", extensions_pref, oracle["Extensions préférées"]),
+        ("VE-ST", extensions_stable, oracle["Extensions stables"]),
+        ("SE-GR", [call_extension("SE-GR", fichier)], oracle["Extension fondée"]),
+        ("DC-PR", [set(dc_pr)], oracle["DC-PR"]), ("DS-PR", [set(ds_pr)], oracle["DS-PR"]),
+        ("DC-ST", [set(dc_st)], oracle["DC-ST"]), ("DS-ST", [set(ds_st)], oracle["DS-ST"]),
+        ("DC-CO", [set(dc_co)], oracle["DC-CO"]), ("DS-CO", [set(ds_co)], oracle["DS-CO"]),
+    )
+    for probleme, obtenu, attendu in comparaisons:
+        identique = sorted(map(sorted, obtenu)) == sorted(map(sorted, attendu))
+        print(f"  - {probleme} : {'OK' if identique else f'ERREUR, attendu {attendu}'}")
+    # SE-ST : n'importe quelle extension stable convient, NO seulement s'il n'y en a aucune
+    stables = oracle["Extensions stables"]
+    correct = extension_stable in stables if extension_stable is not None else not stables
+    print(f"  - SE-ST : {'OK' if correct else f'ERREUR, attendu une extension parmi {stables}'}")
+    # Témoins d'un non sceptique : une extension sans l'argument, absente seulement s'il n'existe aucune extension
+    for probleme, acceptes, extensions in (("DS-PR", ds_pr, oracle["Extensions préférées"]), ("DS-ST", ds_st, stables)):
+        erreurs = []
+        for arg in arguments:
+            if arg in acceptes:
+                continue
+            temoin = call_temoin(probleme, fichier, arg)
+            valide = temoin in extensions and arg not in temoin if temoin is not None else not extensions
+            if not valide:
+                erreurs.append(f"{arg} : {temoin}")
+        print(f"  - Témoins {probleme} : {'OK' if not erreurs else 'ERREUR, ' + ', '.join(erreurs)}")
 
 if __name__ == "__main__":
     main()